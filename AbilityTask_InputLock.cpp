@@ -1,5 +1,9 @@
 #include "AbilityTask_InputLock.h"
 #include "AbilitySystemComponent.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBDebug.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerController.h"
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_InputLock)
@@ -27,11 +31,11 @@ UAbilityTask_InputLock* UAbilityTask_InputLock::SetInputLockState(UGameplayAbili
 {
 	if (!OwningAbility)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("SetInputLockState: OwningAbility is null"));
+		GASDB_LOG(nullptr, Warning, TEXT("SetInputLockState: OwningAbility is null"));
 		return nullptr;
 	}
 
-	UAbilityTask_InputLock* Task = NewAbilityTask<UAbilityTask_InputLock>(OwningAbility);
+	UAbilityTask_InputLock* Task = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_InputLock>(OwningAbility);
 	Task->LockDuration = Duration;
 	Task->bLockMoveInput = bLockMove;
 	Task->bLockLookInput = bLockLook;
@@ -40,44 +44,62 @@ UAbilityTask_InputLock* UAbilityTask_InputLock::SetInputLockState(UGameplayAbili
 	return Task;
 }
 
+EGASDBInputLockChannel UAbilityTask_InputLock::GetLockChannels() const
+{
+	EGASDBInputLockChannel Channels = EGASDBInputLockChannel::None;
+	if (bLockMoveInput)
+	{
+		Channels |= EGASDBInputLockChannel::Move;
+	}
+	if (bLockLookInput)
+	{
+		Channels |= EGASDBInputLockChannel::Look;
+	}
+	return Channels;
+}
+
+const UObject* UAbilityTask_InputLock::GetLockReason() const
+{
+	return Ability;
+}
+
 void UAbilityTask_InputLock::Activate()
 {
+	GASDB_SCOPE(InputLock_Activate);
+
+	GASDB_RECORD(RecordInputLock(this, bIsLocking, static_cast<uint8>(InputLockType), LockDuration, bLockMoveInput, bLockLookInput));
+
 	APlayerController* PC = GetPlayerController();
-	if (!PC)
+	UGASDBInputLockSubsystem* LockSubsystem = UGASDBInputLockSubsystem::Get(PC);
+	if (!PC || !LockSubsystem)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("SetInputLockState: Unable to find a valid PlayerController."));
+		GASDB_LOG(this, Warning, TEXT("SetInputLockState: Unable to find a valid PlayerController."));
 		EndTask();
 		return;
 	}
 
 	if (bIsLocking)
 	{
-		// Lock the input as specified.
-		PC->SetIgnoreMoveInput(bLockMoveInput);
-		PC->SetIgnoreLookInput(bLockLookInput);
-
-		// If using the timed lock option, set a timer to unlock input after the duration expires.
 		if (InputLockType == EInputLockType::Timed)
 		{
 			if (LockDuration > 0.f)
 			{
-				if (UWorld* World = GetWorld())
-				{
-					World->GetTimerManager().SetTimer(TimerHandle, this, &UAbilityTask_InputLock::ReEnableInput, LockDuration, false);
-				}
-				else
-				{
-					UE_LOG(LogTemp, Warning, TEXT("SetInputLockState: World context is invalid; unlocking input immediately."));
-					ReEnableInput();
-				}
+				// The subsystem owns the expiry; this task only waits to report it.
+				LockHandle = LockSubsystem->Lock(PC, GetLockChannels(), LockDuration, GetLockReason(),
+					FGASDBOnInputLockReleased::CreateUObject(this, &UAbilityTask_InputLock::OnLockReleased));
 			}
 			else
 			{
-				// If no valid duration provided, immediately unlock input.
-				ReEnableInput();
+				// If no valid duration provided, the lock is over immediately.
+				OnLockReleased();
 			}
 		}
-		// For a permanent lock, no timer is set.
+		else
+		{
+			// A permanent lock lives in the subsystem until explicitly unlocked; nothing left for this task to do.
+			LockSubsystem->Lock(PC, GetLockChannels(), 0.f, GetLockReason());
+			EndTask();
+		}
 	}
 	else
 	{
@@ -88,20 +110,25 @@ void UAbilityTask_InputLock::Activate()
 
 void UAbilityTask_InputLock::ReEnableInput()
 {
-	APlayerController* PC = GetPlayerController();
-	if (PC)
+	if (UGASDBInputLockSubsystem* LockSubsystem = UGASDBInputLockSubsystem::Get(this))
 	{
-		// Only unlock input for those that were originally locked.
-		if (bLockMoveInput)
-		{
-			PC->SetIgnoreMoveInput(false);
-		}
-		if (bLockLookInput)
+		// Only releases the requests this ability holds on this character; other abilities' locks stay in place.
+		// The controller filter matters for non-instanced abilities, whose reason is shared by every character.
+		if (const APlayerController* PC = GetPlayerController())
 		{
-			PC->SetIgnoreLookInput(false);
+			LockSubsystem->UnlockAllForReason(GetLockReason(), GetLockChannels(), PC);
 		}
 	}
 
+	OnLockReleased();
+}
+
+void UAbilityTask_InputLock::OnLockReleased()
+{
+	GASDB_SCOPE(InputLock_LockReleased);
+
+	LockHandle.Reset();
+
 	// Notify listeners that the input lock state change has been completed.
 	if (ShouldBroadcastAbilityTaskDelegates())
 	{
@@ -110,3 +137,31 @@ void UAbilityTask_InputLock::ReEnableInput()
 
 	EndTask();
 }
+
+void UAbilityTask_InputLock::OnDestroy(const bool bInOwnerFinished)
+{
+	// A timed lock outlives the task (e.g. when the ability ends early); it just stops reporting back to us.
+	if (LockHandle.IsValid())
+	{
+		if (UGASDBInputLockSubsystem* LockSubsystem = UGASDBInputLockSubsystem::Get(this))
+		{
+			LockSubsystem->ClearReleaseCallback(LockHandle);
+		}
+		LockHandle.Reset();
+	}
+
+	Super::OnDestroy(bInOwnerFinished);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_InputLock::ResetPooledState()
+{
+	LockDuration = 0.f;
+	bLockMoveInput = true;
+	bLockLookInput = true;
+	bIsLocking = true;
+	InputLockType = EInputLockType::Timed;
+	LockHandle.Reset();
+	bOwnerFinished = false;
+}
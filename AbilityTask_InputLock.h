@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/Tasks/AbilityTask.h"
+#include "GASDBInputLockSubsystem.h"
 #include "AbilityTask_InputLock.generated.h"
 
 /** Enum that determines whether the input lock is timed or permanent */
@@ -48,12 +49,20 @@ public:
 
 	virtual void Activate() override;
 
+protected:
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+
 private:
+	friend class UGASDBAbilityTaskPool;
+
+	/** Restores constructor defaults before the task is reused from the pool */
+	void ResetPooledState();
+
 	/** Duration for which input is locked (only valid when LockType is Timed) */
 	float LockDuration;
 
-	/** Timer handle for managing the lock duration */
-	FTimerHandle TimerHandle;
+	/** Lock request held in the input lock subsystem (only valid while a timed lock is pending) */
+	FGASDBInputLockHandle LockHandle;
 
 	/** Cached flags for input locking options */
 	bool bLockMoveInput;
@@ -65,10 +74,19 @@ private:
 	/** Specifies if the lock type is Timed or Permanent */
 	EInputLockType InputLockType;
 
-	/** Called by the timer to unlock input (or finish the unlocking process) */
+	/** Releases the owning ability's locks on this character's configured channels (or finishes the unlocking process) */
 	UFUNCTION()
 	void ReEnableInput();
 
+	/** Called by the input lock subsystem when the timed lock expires or is released for this character */
+	void OnLockReleased();
+
+	/** Channels selected by bLockMoveInput / bLockLookInput */
+	EGASDBInputLockChannel GetLockChannels() const;
+
+	/** Locks are held on behalf of the owning ability, so only an unlock from the same ability releases them */
+	const UObject* GetLockReason() const;
+
 	/** Helper method to get the PlayerController from the avatar */
 	APlayerController* GetPlayerController() const;
 };
@@ -3,8 +3,13 @@
 #include "AbilityTask_InstantMoveToLocation.h"
 #include "AbilitySystemComponent.h"
 #include "Components/SceneComponent.h"
-#include "AbilitySystemLog.h"
 #include "GameFramework/Actor.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBDebug.h"
+#include "GASDBLatencyTracer.h"
+#include "GASDBTaskBudgetSubsystem.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
 #include "Net/UnrealNetwork.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_InstantMoveToLocation)
@@ -18,7 +23,7 @@ UAbilityTask_InstantMoveToLocation::UAbilityTask_InstantMoveToLocation(const FOb
 
 UAbilityTask_InstantMoveToLocation* UAbilityTask_InstantMoveToLocation::InstantMoveToLocation(UGameplayAbility* OwningAbility, FVector TargetLocation, FRotator TargetRotation, bool bSweep, bool bStopAtCollision, bool bSetRotation)
 {
-	UAbilityTask_InstantMoveToLocation* Task = NewAbilityTask<UAbilityTask_InstantMoveToLocation>(OwningAbility);
+	UAbilityTask_InstantMoveToLocation* Task = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_InstantMoveToLocation>(OwningAbility);
 	Task->DestinationLocation = TargetLocation;
 	Task->DestinationRotation = TargetRotation;
 	Task->bDoSweep = bSweep;
@@ -28,45 +33,95 @@ UAbilityTask_InstantMoveToLocation* UAbilityTask_InstantMoveToLocation::InstantM
 	return Task;
 }
 
-void UAbilityTask_InstantMoveToLocation::ExecuteMove()
+bool UAbilityTask_InstantMoveToLocation::ApplyInstantMove(AActor* Actor, const FVector& TargetLocation, const FRotator& TargetRotation, const bool bInSweep, const bool bInStopAtCollision, const bool bInSetRotation)
 {
-	AActor* MyActor = GetAvatarActor();
-	if (!MyActor)
+	GASDB_SCOPE(InstantMove_ApplyMove);
+
+	if (!Actor)
 	{
-		ABILITY_LOG(Warning, TEXT("UAbilityTask_InstantMoveToLocation called in Ability %s but AvatarActor is null."),
-			Ability ? *Ability->GetName() : TEXT("NULL"));
-		EndTask();
-		return;
+		return false;
+	}
+
+	if (bInSweep)
+	{
+		GASDB_COUNT_SCENE_QUERY();
 	}
 
 	FHitResult Hit;
-	const bool bTeleportSuccess = bDoSweep ? MyActor->SetActorLocation(DestinationLocation, true, &Hit, ETeleportType::TeleportPhysics) 
-										   : MyActor->SetActorLocation(DestinationLocation, false, nullptr, ETeleportType::TeleportPhysics);
+	const bool bTeleportSuccess = bInSweep ? Actor->SetActorLocation(TargetLocation, true, &Hit, ETeleportType::TeleportPhysics) 
+										 : Actor->SetActorLocation(TargetLocation, false, nullptr, ETeleportType::TeleportPhysics);
 
 	// Check for unsuccessful teleport due to blocking hit
 	if (!bTeleportSuccess)
 	{
-		if (bStopAtCollision && Hit.bBlockingHit)
+		if (bInStopAtCollision && Hit.bBlockingHit)
 		{
 			// Adjust the destination to the hit location or handle as needed
 			FVector AdjustedLocation = Hit.Location; // Customize this adjustment as required
-			MyActor->SetActorLocation(AdjustedLocation, false, nullptr, ETeleportType::TeleportPhysics);
+			Actor->SetActorLocation(AdjustedLocation, false, nullptr, ETeleportType::TeleportPhysics);
 		}
 		else
 		{
-			// Handle cases where teleport fails but no blocking hit is involved
-			OnFail.Broadcast();
-			EndTask();
-			return;
+			return false;
 		}
 	}
 
 	// Apply rotation if needed
-	if (bSetRotation)
+	if (bInSetRotation)
+	{
+		Actor->SetActorRotation(TargetRotation);
+	}
+
+	return true;
+}
+
+bool UAbilityTask_InstantMoveToLocation::IsDestinationBlocked(const AActor* Actor, const FVector& TargetLocation, const FCollisionShape& CollisionShape)
+{
+	GASDB_SCOPE(InstantMove_DestinationQuery);
+
+	UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	if (!World)
+	{
+		return false;
+	}
+
+	// Setup query parameters
+	FCollisionQueryParams QueryParams;
+	QueryParams.AddIgnoredActor(Actor);
+
+	// Check for overlap at the target location
+	GASDB_COUNT_SCENE_QUERY();
+	return World->OverlapBlockingTestByChannel(TargetLocation, FQuat::Identity, ECC_Visibility, CollisionShape, QueryParams);
+}
+
+void UAbilityTask_InstantMoveToLocation::ExecuteMove()
+{
+	AActor* MyActor = GetAvatarActor();
+	if (!MyActor)
 	{
-		MyActor->SetActorRotation(DestinationRotation);
+		GASDB_LOG(this, Warning, TEXT("UAbilityTask_InstantMoveToLocation called in Ability %s but AvatarActor is null."), *GetNameSafe(Ability));
+		EndTask();
+		return;
+	}
+
+	const bool bMoved = ApplyInstantMove(MyActor, DestinationLocation, DestinationRotation, bDoSweep, bStopAtCollision, bSetRotation);
+
+	if (bDoSweep)
+	{
+		GASDB_LATENCY_STAGE(Ability, SceneQueryDone);
+	}
+
+	if (!bMoved)
+	{
+		// Handle cases where teleport fails but no blocking hit is involved
+		GASDB_LATENCY_DISCARD(Ability);
+		OnFail.Broadcast();
+		EndTask();
+		return;
 	}
 
+	GASDB_LATENCY_STAGE(Ability, EffectApplied);
+
 	// Broadcast successful move completion
 	OnInstantMoveCompleted.Broadcast(DestinationLocation);
 	EndTask();
@@ -76,9 +131,21 @@ void UAbilityTask_InstantMoveToLocation::ExecuteMove()
 
 void UAbilityTask_InstantMoveToLocation::Activate()
 {
+	GASDB_SCOPE(InstantMove_Activate);
+
+	UGASDBTaskBudgetSubsystem* Budget = UGASDBTaskBudgetSubsystem::GetIfEnabled(this);
+	if (Budget && Budget->TryDeferActivation(this, EGASDBTaskBudgetCategory::Placement, FSimpleDelegate::CreateUObject(this, &UAbilityTask_InstantMoveToLocation::Activate)))
+	{
+		return;
+	}
+	GASDB_BUDGET_SCOPE(Placement);
+
 	// Define the collision shape, perhaps based on the actor's bounding box or a custom shape
 	const FCollisionShape CollisionShape = FCollisionShape::MakeSphere(50.0f);
 
+	GASDB_LATENCY_STAGE(Ability, TaskActivated);
+	GASDB_RECORD(RecordInstantMove(this, DestinationLocation, DestinationRotation, bDoSweep, bStopAtCollision, bSetRotation));
+
 	if (bDoSweep)
 	{
 		// If sweeping is enabled, directly execute the move
@@ -97,6 +164,7 @@ void UAbilityTask_InstantMoveToLocation::Activate()
 	else
 	{
 		// Collision detected and not stopping at collision
+		GASDB_LATENCY_DISCARD(Ability);
 		OnFail.Broadcast();
 		EndTask();
 	}
@@ -112,18 +180,14 @@ bool UAbilityTask_InstantMoveToLocation::CheckCollisionAtDestination(const FVect
 		return false;
 	}
 
-	// Setup query parameters
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(MyActor);
+	bool bCollision = IsDestinationBlocked(MyActor, TargetLocation, CollisionShape);
 
-	// Check for overlap at the target location
-	bool bCollision = GetWorld()->OverlapBlockingTestByChannel(TargetLocation, FQuat::Identity, ECC_Visibility, CollisionShape, QueryParams);
+	GASDB_LATENCY_STAGE(Ability, SceneQueryDone);
 
-#if WITH_EDITOR
-	if (GEngine)
+#if WITH_EDITOR && !GASDB_STRIP_DEBUG
+	if (GEngine && GASDBDebug::IsEnabled(this))
 	{
-		const FString CollisionResult = bCollision ? TEXT("True, Collision detected") : TEXT("False, No collision");
-		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("Collision Check: %s"), *CollisionResult));
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, bCollision ? TEXT("Collision Check: True, Collision detected") : TEXT("Collision Check: False, No collision"));
 		DrawDebugSphere(GetWorld(), TargetLocation, CollisionShape.GetSphereRadius(), 32, bCollision ? FColor::Red : FColor::Green, false, 5.0f);
 	}
 #endif
@@ -133,6 +197,23 @@ bool UAbilityTask_InstantMoveToLocation::CheckCollisionAtDestination(const FVect
 
 
 
+void UAbilityTask_InstantMoveToLocation::OnDestroy(const bool bInOwnerFinished)
+{
+	Super::OnDestroy(bInOwnerFinished);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_InstantMoveToLocation::ResetPooledState()
+{
+	DestinationLocation = FVector::ZeroVector;
+	DestinationRotation = FRotator::ZeroRotator;
+	bDoSweep = false;
+	bStopAtCollision = false;
+	bSetRotation = true;
+	bOwnerFinished = false;
+}
+
 void UAbilityTask_InstantMoveToLocation::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
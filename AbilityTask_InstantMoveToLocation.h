@@ -30,11 +30,25 @@ class LYRAGAME_API UAbilityTask_InstantMoveToLocation : public UAbilityTask
 	static UAbilityTask_InstantMoveToLocation* InstantMoveToLocation(UGameplayAbility* OwningAbility, FVector TargetLocation, FRotator TargetRotation, bool bSweep, bool bStopAtCollision, bool bSetRotation = true);
 	virtual void GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const override;
 
+	/** Moves the actor the same way this task does, without a task. Returns false if the move was blocked. */
+	static bool ApplyInstantMove(AActor* Actor, const FVector& TargetLocation, const FRotator& TargetRotation, bool bInSweep, bool bInStopAtCollision, bool bInSetRotation);
+
+	/** True if CollisionShape overlaps blocking geometry at TargetLocation, ignoring Actor itself. */
+	static bool IsDestinationBlocked(const AActor* Actor, const FVector& TargetLocation, const FCollisionShape& CollisionShape);
+
 	
 protected:
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+
 	FVector DestinationLocation;
 	FRotator DestinationRotation;
 	bool bDoSweep;
 	bool bStopAtCollision;
 	bool bSetRotation;
+
+private:
+	friend class UGASDBAbilityTaskPool;
+
+	/** Restores constructor defaults before the task is reused from the pool */
+	void ResetPooledState();
 };
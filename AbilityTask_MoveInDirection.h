@@ -30,6 +30,14 @@ protected:
 	void MoveCharacter();
 
 private:
+	friend class UGASDBAbilityTaskPool;
+
+	/** Restores constructor defaults before the task is reused from the pool */
+	void ResetPooledState();
+
 	UPROPERTY()
 	UGameplayAbility* OwningAbility;
+
+	/** GFrameCounter of the last update, so an over-budget frame can drop repeated timer firings */
+	uint64 LastUpdateFrame = MAX_uint64;
 };
@@ -1,13 +1,18 @@
 // AbilityTask_MoveRandomly.cpp
 
 #include "AbilityTask_MoveRandomly.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBEventBatchSubsystem.h"
+#include "GASDBTaskBudgetSubsystem.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
 
 UAbilityTask_MoveRandomly* UAbilityTask_MoveRandomly::MoveRandomlyTask(UGameplayAbility* OwningAbility, FName TaskInstanceName, float DirectionChangeInterval, float TotalDuration)
 {
-	UAbilityTask_MoveRandomly* MyTask = NewAbilityTask<UAbilityTask_MoveRandomly>(OwningAbility, TaskInstanceName);
+	UAbilityTask_MoveRandomly* MyTask = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_MoveRandomly>(OwningAbility, TaskInstanceName);
 	MyTask->DirectionChangeInterval = DirectionChangeInterval;
 	MyTask->TotalDuration = TotalDuration;
 	MyTask->OwningAbility = OwningAbility;
@@ -17,11 +22,22 @@ UAbilityTask_MoveRandomly* UAbilityTask_MoveRandomly::MoveRandomlyTask(UGameplay
 	return MyTask;
 }
 
+UAbilityTask_MoveRandomly* UAbilityTask_MoveRandomly::MoveRandomlyBatched(UGameplayAbility* OwningAbility, FName TaskInstanceName, float DirectionChangeInterval, float TotalDuration)
+{
+	UAbilityTask_MoveRandomly* MyTask = MoveRandomlyTask(OwningAbility, TaskInstanceName, DirectionChangeInterval, TotalDuration);
+	MyTask->bBatchedDelivery = true;
+	return MyTask;
+}
+
 void UAbilityTask_MoveRandomly::Activate()
 {
+	GASDB_SCOPE(MoveRandomly_Activate);
+
 	Super::Activate();
+	GASDB_RECORD(RecordMoveRandomly(this, DirectionChangeInterval, TotalDuration));
 	ChangeDirection();  // Set initial direction
 	GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UAbilityTask_MoveRandomly::MoveCharacter, 0.015f, true);
+	FGASDBTaskMetrics::NoteTimerSet(TimerHandle);
 }
 
 void UAbilityTask_MoveRandomly::MoveCharacter()
@@ -29,6 +45,15 @@ void UAbilityTask_MoveRandomly::MoveCharacter()
 	TimePassed += 0.015f;
 	TimeSinceLastDirectionChange += 0.015f;
 
+	// The input of a second firing in the same frame would be summed into the first and clamped away.
+	if (TimePassed < TotalDuration && UGASDBTaskBudgetSubsystem::ShouldCollapseUpdate(this, EGASDBTaskBudgetCategory::Movement, LastUpdateFrame))
+	{
+		return;
+	}
+
+	GASDB_SCOPE(MoveRandomly_TimerCallback);
+	GASDB_BUDGET_SCOPE(Movement);
+
 	if (TimePassed >= TotalDuration)
 	{
 		HandleMoveRandomlyEnd();
@@ -57,13 +82,38 @@ void UAbilityTask_MoveRandomly::HandleMoveRandomlyEnd()
 {
 	if (ShouldBroadcastAbilityTaskDelegates())
 	{
-		OnMoveRandomlyEnd.Broadcast();
+		UGASDBEventBatchSubsystem* EventBatch = bBatchedDelivery ? UGASDBEventBatchSubsystem::GetIfBatching(this) : nullptr;
+		if (!EventBatch || !EventBatch->QueueMovementEnded(this))
+		{
+			OnMoveRandomlyEnd.Broadcast();
+		}
 	}
-	OnDestroy(false);
+	EndTask();
 }
 
 void UAbilityTask_MoveRandomly::OnDestroy(bool AbilityEnded)
 {
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+	if (UWorld* World = GetWorld())
+	{
+		FGASDBTaskMetrics::ClearTimer(World->GetTimerManager(), TimerHandle);
+	}
+	TimerHandle.Invalidate();
+
 	Super::OnDestroy(AbilityEnded);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_MoveRandomly::ResetPooledState()
+{
+	DirectionChangeInterval = 0.f;
+	TotalDuration = 0.f;
+	TimePassed = 0.f;
+	TimeSinceLastDirectionChange = 0.f;
+	TimerHandle.Invalidate();
+	OwningAbility = nullptr;
+	CurrentMoveDirection = FVector::ZeroVector;
+	LastUpdateFrame = MAX_uint64;
+	bBatchedDelivery = false;
+	bOwnerFinished = false;
 }
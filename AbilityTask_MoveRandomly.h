@@ -17,6 +17,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
 	static UAbilityTask_MoveRandomly* MoveRandomlyTask(UGameplayAbility* OwningAbility, FName TaskInstanceName, float DirectionChangeInterval, float TotalDuration);
 
+	/** Like MoveRandomlyTask, but with gasdb.Events.BatchedDelivery on and a listener bound, the end is delivered through UGASDBEventBatchSubsystem::OnMovementEnded instead of OnMoveRandomlyEnd */
+	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+	static UAbilityTask_MoveRandomly* MoveRandomlyBatched(UGameplayAbility* OwningAbility, FName TaskInstanceName, float DirectionChangeInterval, float TotalDuration);
+
 	virtual void Activate() override;
 	virtual void OnDestroy(bool AbilityEnded) override;
 
@@ -37,8 +41,18 @@ protected:
 	FOnMoveRandomlyEndDelegate OnMoveRandomlyEnd;
 
 private:
+	friend class UGASDBAbilityTaskPool;
+
+	/** Restores constructor defaults before the task is reused from the pool */
+	void ResetPooledState();
+
 	UPROPERTY()
 	UGameplayAbility* OwningAbility;
 
 	FVector CurrentMoveDirection;
+
+	/** GFrameCounter of the last update, so an over-budget frame can drop repeated timer firings */
+	uint64 LastUpdateFrame = MAX_uint64;
+
+	bool bBatchedDelivery = false;
 };
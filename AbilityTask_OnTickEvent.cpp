@@ -2,6 +2,14 @@
 
 
 #include "AbilityTask_OnTickEvent.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBEventBatchSubsystem.h"
+#include "GASDBSimulatedTaskSubsystem.h"
+#include "GASDBTaskBudgetSubsystem.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
+#include "Net/UnrealNetwork.h"
 
 
 UAbilityTask_OnTickEvent::UAbilityTask_OnTickEvent()
@@ -12,18 +20,82 @@ UAbilityTask_OnTickEvent::UAbilityTask_OnTickEvent()
 
 UAbilityTask_OnTickEvent* UAbilityTask_OnTickEvent::OnTickEvent(UGameplayAbility* OwningAbility, const FName TaskInstanceName)
 {
-	return NewAbilityTask<UAbilityTask_OnTickEvent>(OwningAbility, TaskInstanceName);
+	return UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_OnTickEvent>(OwningAbility, TaskInstanceName);
+}
+
+UAbilityTask_OnTickEvent* UAbilityTask_OnTickEvent::OnTickEventWhenRelevant(UGameplayAbility* OwningAbility, const FName TaskInstanceName)
+{
+	UAbilityTask_OnTickEvent* MyTask = OnTickEvent(OwningAbility, TaskInstanceName);
+	MyTask->bOnlyTickWhenRelevant = true;
+	return MyTask;
+}
+
+UAbilityTask_OnTickEvent* UAbilityTask_OnTickEvent::OnTickEventBatched(UGameplayAbility* OwningAbility, const FName TaskInstanceName)
+{
+	UAbilityTask_OnTickEvent* MyTask = OnTickEvent(OwningAbility, TaskInstanceName);
+	MyTask->bBatchedDelivery = true;
+	return MyTask;
+}
+
+void UAbilityTask_OnTickEvent::Activate()
+{
+	Super::Activate();
+
+	GASDB_RECORD(RecordOnTickEvent(this));
+
+	if (bOnlyTickWhenRelevant && IsSimulatedTask() && Ability && Ability->GetCurrentActorInfo()->IsNetAuthority())
+	{
+		if (UGASDBSimulatedTaskSubsystem* SimulatedTasks = UGASDBSimulatedTaskSubsystem::Get(this))
+		{
+			SimulatedTasks->RegisterServerTask(this);
+		}
+	}
+}
+
+void UAbilityTask_OnTickEvent::InitSimulatedTask(UGameplayTasksComponent& InGameplayTasksComponent)
+{
+	Super::InitSimulatedTask(InGameplayTasksComponent);
+
+	if (bOnlyTickWhenRelevant)
+	{
+		if (UGASDBSimulatedTaskSubsystem* SimulatedTasks = UGASDBSimulatedTaskSubsystem::Get(this))
+		{
+			SimulatedTasks->RegisterClientTask(this);
+		}
+	}
 }
 
 void UAbilityTask_OnTickEvent::TickTask(const float DeltaTime)
 {
+	GASDB_SCOPE(OnTickEvent_TickTask);
+
+	if (bSimulationPaused)
+	{
+		return;
+	}
+
+	// Only simulated copies are cosmetic; the authoritative and predicting tasks always tick.
+	const FGASDBTaskBudgetScope BudgetScope(IsSimulating() ? this : nullptr, EGASDBTaskBudgetCategory::Simulated);
+	if (BudgetScope.ShouldSkipUpdate(this))
+	{
+		SkippedDeltaTime += DeltaTime;
+		return;
+	}
+
 	Super::TickTask(DeltaTime);
 
-	EventReceived(DeltaTime);
+	EventReceived(DeltaTime + SkippedDeltaTime);
+	SkippedDeltaTime = 0.f;
 }
 
-void UAbilityTask_OnTickEvent::EventReceived(const float DeltaTime) const
+void UAbilityTask_OnTickEvent::EventReceived(const float DeltaTime)
 {
+	UGASDBEventBatchSubsystem* EventBatch = bBatchedDelivery ? UGASDBEventBatchSubsystem::GetIfBatching(this) : nullptr;
+	if (EventBatch && EventBatch->QueueTickEvent(this, DeltaTime))
+	{
+		return;
+	}
+
 	if (TickEventReceived.IsBound())
 	{
 		TickEventReceived.Broadcast(DeltaTime);
@@ -33,6 +105,32 @@ void UAbilityTask_OnTickEvent::EventReceived(const float DeltaTime) const
 void UAbilityTask_OnTickEvent::OnDestroy(const bool bInOwnerFinished)
 {
 	bTickingTask = false;
+
+	if (!RelevancyNetGroup.IsNone())
+	{
+		UE::Net::FNetConditionGroupManager::UnregisterSubObjectFromGroup(this, RelevancyNetGroup);
+		RelevancyNetGroup = NAME_None;
+	}
 	
 	Super::OnDestroy(bInOwnerFinished);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_OnTickEvent::ResetPooledState()
+{
+	bTickingTask = true;
+	bOnlyTickWhenRelevant = false;
+	bBatchedDelivery = false;
+	bSimulationPaused = false;
+	SkippedDeltaTime = 0.f;
+	RelevancyNetGroup = NAME_None;
+	bOwnerFinished = false;
+}
+
+void UAbilityTask_OnTickEvent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UAbilityTask_OnTickEvent, bOnlyTickWhenRelevant);
 }
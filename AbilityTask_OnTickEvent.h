@@ -24,11 +24,51 @@ public:
 	UFUNCTION(BlueprintCallable, Meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "True"), Category = "Ability Tasks")
 	static UAbilityTask_OnTickEvent* OnTickEvent(UGameplayAbility* OwningAbility, const FName TaskInstanceName);
 
+	// Like OnTickEvent, but simulated proxies only receive and tick the task while its avatar is relevant to them.
+	// See UGASDBSimulatedTaskSubsystem.
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "True"), Category = "Ability Tasks")
+	static UAbilityTask_OnTickEvent* OnTickEventWhenRelevant(UGameplayAbility* OwningAbility, const FName TaskInstanceName);
+
+	// Like OnTickEvent, but with gasdb.Events.BatchedDelivery on and a listener bound, ticks are delivered through
+	// UGASDBEventBatchSubsystem::OnTickEvents once per frame instead of through TickEventReceived.
+	UFUNCTION(BlueprintCallable, Meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "True"), Category = "Ability Tasks")
+	static UAbilityTask_OnTickEvent* OnTickEventBatched(UGameplayAbility* OwningAbility, const FName TaskInstanceName);
+
+	virtual void Activate() override;
+
+	virtual void InitSimulatedTask(UGameplayTasksComponent& InGameplayTasksComponent) override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 
 	virtual void TickTask(const float DeltaTime) override;
 	
-	void EventReceived(const float DeltaTime) const;
+	void EventReceived(const float DeltaTime);
 
 	virtual void OnDestroy(const bool bInOwnerFinished) override;
+
+private:
+
+	friend class UGASDBAbilityTaskPool;
+	friend class UGASDBSimulatedTaskSubsystem;
+
+	// Simulated proxies only run this task while the avatar is relevant to them.
+	UPROPERTY(Replicated)
+	bool bOnlyTickWhenRelevant = false;
+
+	// Created through OnTickEventBatched.
+	bool bBatchedDelivery = false;
+
+	// Set on clients by UGASDBSimulatedTaskSubsystem while the avatar is out of range.
+	bool bSimulationPaused = false;
+
+	// Tick time skipped by the task budget governor, handed to the next tick that runs.
+	float SkippedDeltaTime = 0.f;
+
+	// Server: the net condition group this task replicates through, if it was moved to one.
+	FName RelevancyNetGroup;
+
+	// Restores constructor defaults before the task is reused from the pool.
+	void ResetPooledState();
 };
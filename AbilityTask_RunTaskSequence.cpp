@@ -0,0 +1,435 @@
+#include "AbilityTask_RunTaskSequence.h"
+#include "AbilitySystemComponent.h"
+#include "AbilityTask_InstantMoveToLocation.h"
+#include "AbilityTask_SpawnSafeActor.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBDebug.h"
+#include "GASDBInputBufferSubsystem.h"
+#include "GASDBInputForwardingComponent.h"
+#include "GASDBLatencyTracer.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "InputAction.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AbilityTask_RunTaskSequence)
+
+UAbilityTask_RunTaskSequence::UAbilityTask_RunTaskSequence(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	bTickingTask = true;
+}
+
+UAbilityTask_RunTaskSequence* UAbilityTask_RunTaskSequence::RunTaskSequence(UGameplayAbility* OwningAbility, FName TaskInstanceName, const TArray<FGASDBTaskStep>& Steps, EGASDBTaskSequenceMode Mode)
+{
+	UAbilityTask_RunTaskSequence* MyTask = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_RunTaskSequence>(OwningAbility, TaskInstanceName);
+	MyTask->Mode = Mode;
+	MyTask->Steps.Append(Steps);
+	MyTask->StepStates.SetNum(Steps.Num());
+
+	for (FGASDBTaskStep& Step : MyTask->Steps)
+	{
+		Step.Direction = Step.Direction.GetSafeNormal();
+	}
+
+	return MyTask;
+}
+
+APlayerController* UAbilityTask_RunTaskSequence::GetPlayerController() const
+{
+	if (AActor* Avatar = GetAvatarActor())
+	{
+		return Cast<APlayerController>(Avatar->GetInstigatorController());
+	}
+	return nullptr;
+}
+
+void UAbilityTask_RunTaskSequence::Activate()
+{
+	GASDB_SCOPE(RunTaskSequence_Activate);
+
+	Super::Activate();
+
+	GASDB_LATENCY_STAGE(Ability, TaskActivated);
+	GASDB_RECORD(RecordTaskSequence(this, Steps, Mode));
+
+	if (Mode == EGASDBTaskSequenceMode::Parallel)
+	{
+		for (int32 StepIndex = 0; StepIndex < Steps.Num() && !IsFinished(); ++StepIndex)
+		{
+			StartStep(StepIndex);
+		}
+		NextStepIndex = Steps.Num();
+	}
+
+	if (!IsFinished())
+	{
+		AdvanceSequence();
+	}
+}
+
+void UAbilityTask_RunTaskSequence::TickTask(float DeltaTime)
+{
+	GASDB_SCOPE(RunTaskSequence_TickTask);
+
+	Super::TickTask(DeltaTime);
+
+	for (int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex)
+	{
+		if (StepStates[StepIndex].Status == EStepStatus::Running)
+		{
+			TickStep(StepIndex, DeltaTime);
+			if (IsFinished())
+			{
+				return;
+			}
+		}
+	}
+
+	AdvanceSequence();
+}
+
+void UAbilityTask_RunTaskSequence::AdvanceSequence()
+{
+	// Start steps until one of them has to wait; instant steps finish inside StartStep.
+	while (NextStepIndex < Steps.Num())
+	{
+		if (NextStepIndex > 0 && StepStates[NextStepIndex - 1].Status == EStepStatus::Running)
+		{
+			return;
+		}
+
+		StartStep(NextStepIndex++);
+		if (IsFinished())
+		{
+			return;
+		}
+	}
+
+	if (NumFinishedSteps == Steps.Num())
+	{
+		OnCompleted.Broadcast();
+		EndTask();
+	}
+}
+
+void UAbilityTask_RunTaskSequence::StartStep(int32 StepIndex)
+{
+	const FGASDBTaskStep& Step = Steps[StepIndex];
+	FStepState& State = StepStates[StepIndex];
+	State.Status = EStepStatus::Running;
+
+	switch (Step.Type)
+	{
+	case EGASDBTaskStepType::LockInput:
+	{
+		APlayerController* PC = GetPlayerController();
+		UGASDBInputLockSubsystem* LockSubsystem = UGASDBInputLockSubsystem::Get(PC);
+		if (PC && LockSubsystem)
+		{
+			const FGASDBInputLockHandle Handle = LockSubsystem->Lock(PC, static_cast<EGASDBInputLockChannel>(Step.LockChannels), Step.Duration, Ability);
+			if (Step.Duration <= 0.f)
+			{
+				State.LockHandle = Handle;
+			}
+		}
+		else
+		{
+			GASDB_LOG(this, Warning, TEXT("RunTaskSequence: step %d has no PlayerController to lock, skipping."), StepIndex);
+		}
+		FinishStep(StepIndex, true);
+		break;
+	}
+
+	case EGASDBTaskStepType::InstantMove:
+	{
+		AActor* MyActor = GetAvatarActor();
+		if (!MyActor)
+		{
+			FinishStep(StepIndex, false);
+			break;
+		}
+
+		if (!Step.bSweep && !Step.bStopAtCollision
+			&& UAbilityTask_InstantMoveToLocation::IsDestinationBlocked(MyActor, Step.Location, FCollisionShape::MakeSphere(50.0f)))
+		{
+			GASDB_LATENCY_STAGE(Ability, SceneQueryDone);
+			FinishStep(StepIndex, false);
+			break;
+		}
+
+		const bool bMoved = UAbilityTask_InstantMoveToLocation::ApplyInstantMove(MyActor, Step.Location, Step.Rotation, Step.bSweep, Step.bStopAtCollision, Step.bSetRotation);
+		if (bMoved)
+		{
+			GASDB_LATENCY_STAGE(Ability, EffectApplied);
+		}
+		FinishStep(StepIndex, bMoved);
+		break;
+	}
+
+	case EGASDBTaskStepType::SpawnActor:
+	{
+		// Spawned actors replicate from the server, so clients treat the step as done.
+		if (!Ability || !Ability->GetCurrentActorInfo()->IsNetAuthority())
+		{
+			FinishStep(StepIndex, true);
+			break;
+		}
+
+		AActor* SpawnedActor = UAbilityTask_SpawnSafeActor::SpawnActorSafely(GetWorld(), Step.ActorClass, FTransform(Step.Rotation, Step.Location), Step.bMoveEncroachingActors);
+		if (SpawnedActor)
+		{
+			GASDB_LATENCY_STAGE(Ability, EffectApplied);
+			OnActorSpawned.Broadcast(StepIndex, SpawnedActor);
+		}
+		if (!IsFinished())
+		{
+			FinishStep(StepIndex, SpawnedActor != nullptr);
+		}
+		break;
+	}
+
+	case EGASDBTaskStepType::WaitInput:
+	{
+		const APlayerController* PC = GetPlayerController();
+		if (!PC)
+		{
+			GASDB_LOG(this, Warning, TEXT("RunTaskSequence: step %d has no PlayerController to wait for input from."), StepIndex);
+			FinishStep(StepIndex, false);
+			break;
+		}
+
+		// A remote player's input only reaches the server through the forwarding component; running on without it would
+		// let the following steps get ahead of the client.
+		if (!PC->IsLocalController())
+		{
+			UGASDBInputForwardingComponent* Forwarding = UGASDBInputForwardingComponent::FindForController(PC);
+			if (!Forwarding || !IsForRemoteClient())
+			{
+				GASDB_LOG(this, Warning, TEXT("RunTaskSequence: step %d waits for input of a remote player, which needs a GASDBInputForwardingComponent on the PlayerController."), StepIndex);
+				FinishStep(StepIndex, false);
+				break;
+			}
+
+			ForwardingComponent = Forwarding;
+			State.ForwardingReceiverHandle = Forwarding->RegisterReceiver(GetAbilitySpecHandle(), Step.InputAction, Step.TriggerEvent,
+				FGASDBOnForwardedInput::CreateUObject(this, &UAbilityTask_RunTaskSequence::ForwardedInputReceived, StepIndex));
+			break;
+		}
+
+		UGASDBInputBufferSubsystem* InputBuffer = UGASDBInputBufferSubsystem::Get(PC);
+		if (!InputBuffer || !InputBuffer->EnsureRecording(PC, Step.InputAction, Step.TriggerEvent))
+		{
+			GASDB_LOG(this, Warning, TEXT("RunTaskSequence: step %d cannot record input, the PlayerController has no Enhanced Input Component."), StepIndex);
+			FinishStep(StepIndex, false);
+			break;
+		}
+
+		State.StartTime = FPlatformTime::Seconds();
+		FInputActionValue Value;
+		if (PollInput(Step, State, Value))
+		{
+			CompleteWaitInput(StepIndex, Value);
+		}
+		break;
+	}
+
+	case EGASDBTaskStepType::MoveInDirection:
+	case EGASDBTaskStepType::WaitTime:
+		if (Step.Duration <= 0.f)
+		{
+			FinishStep(StepIndex, true);
+		}
+		break;
+	}
+}
+
+void UAbilityTask_RunTaskSequence::TickStep(int32 StepIndex, float DeltaTime)
+{
+	const FGASDBTaskStep& Step = Steps[StepIndex];
+	FStepState& State = StepStates[StepIndex];
+	State.Elapsed += DeltaTime;
+
+	switch (Step.Type)
+	{
+	case EGASDBTaskStepType::MoveInDirection:
+	{
+		if (State.Elapsed >= Step.Duration)
+		{
+			FinishStep(StepIndex, true);
+			break;
+		}
+
+		State.TimeSinceMoveInput += DeltaTime;
+		if (State.TimeSinceMoveInput >= Step.Interval)
+		{
+			State.TimeSinceMoveInput = 0.f;
+			if (ACharacter* Character = Cast<ACharacter>(GetAvatarActor()))
+			{
+				Character->AddMovementInput(Step.Direction, 1.0f);
+				GASDB_LATENCY_STAGE(Ability, EffectApplied);
+			}
+		}
+		break;
+	}
+
+	case EGASDBTaskStepType::WaitInput:
+	{
+		FInputActionValue Value;
+		if (PollInput(Step, State, Value))
+		{
+			CompleteWaitInput(StepIndex, Value);
+		}
+		else if (Step.Duration > 0.f && State.Elapsed >= Step.Duration)
+		{
+			FinishStep(StepIndex, false);
+		}
+		break;
+	}
+
+	case EGASDBTaskStepType::WaitTime:
+		if (State.Elapsed >= Step.Duration)
+		{
+			FinishStep(StepIndex, true);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+bool UAbilityTask_RunTaskSequence::PollInput(const FGASDBTaskStep& Step, const FStepState& State, FInputActionValue& OutValue) const
+{
+	if (State.ForwardingReceiverHandle.IsValid())
+	{
+		return State.bForwardedInputReceived;
+	}
+
+	UGASDBInputBufferSubsystem* InputBuffer = UGASDBInputBufferSubsystem::Get(this);
+	if (!InputBuffer)
+	{
+		return false;
+	}
+
+	// Events only allocate here when input actually arrived.
+	TArray<FGASDBBufferedInputEvent> Events;
+	const double LookbackSeconds = (FPlatformTime::Seconds() - State.StartTime) + Step.LookbackWindow;
+	if (InputBuffer->ConsumeEvents(GetPlayerController(), Step.InputAction, Step.TriggerEvent, LookbackSeconds, Events, true, 1) == 0)
+	{
+		return false;
+	}
+
+	OutValue = Events.Last().Value;
+	return true;
+}
+
+void UAbilityTask_RunTaskSequence::CompleteWaitInput(const int32 StepIndex, const FInputActionValue& Value)
+{
+	// The server version of this sequence holds the step until the press arrives; send it reliably, it gates what follows.
+	if (Ability && !IsForRemoteClient() && !Ability->GetCurrentActorInfo()->IsNetAuthority())
+	{
+		if (UGASDBInputForwardingComponent* Forwarding = UGASDBInputForwardingComponent::FindForController(GetPlayerController()))
+		{
+			const FGASDBTaskStep& Step = Steps[StepIndex];
+			Forwarding->SendFinalState(GetAbilitySpecHandle(), Step.InputAction, Step.TriggerEvent, Value);
+		}
+	}
+
+	FinishStep(StepIndex, true);
+}
+
+void UAbilityTask_RunTaskSequence::ForwardedInputReceived(const TConstArrayView<FInputActionValue> Values, const bool bIsFinalState, const int32 StepIndex)
+{
+	// Picked up by the step's next tick, so the sequence advances from TickTask as it does for local input.
+	if (StepStates.IsValidIndex(StepIndex) && StepStates[StepIndex].Status == EStepStatus::Running)
+	{
+		StepStates[StepIndex].bForwardedInputReceived = true;
+	}
+}
+
+void UAbilityTask_RunTaskSequence::StopWaitingForForwardedInput(FStepState& State)
+{
+	if (!State.ForwardingReceiverHandle.IsValid())
+	{
+		return;
+	}
+
+	if (UGASDBInputForwardingComponent* Forwarding = ForwardingComponent.Get())
+	{
+		Forwarding->UnregisterReceiver(State.ForwardingReceiverHandle);
+	}
+	State.ForwardingReceiverHandle.Reset();
+}
+
+void UAbilityTask_RunTaskSequence::FinishStep(int32 StepIndex, bool bSucceeded)
+{
+	FStepState& State = StepStates[StepIndex];
+	if (State.Status != EStepStatus::Running)
+	{
+		return;
+	}
+
+	State.Status = bSucceeded ? EStepStatus::Succeeded : EStepStatus::Failed;
+	++NumFinishedSteps;
+	StopWaitingForForwardedInput(State);
+
+	if (bSucceeded)
+	{
+		OnStepCompleted.Broadcast(StepIndex);
+	}
+	else
+	{
+		GASDB_LATENCY_DISCARD(Ability);
+		OnFailed.Broadcast(StepIndex);
+		EndTask();
+	}
+}
+
+void UAbilityTask_RunTaskSequence::OnDestroy(bool bInOwnerFinished)
+{
+	if (UGASDBInputLockSubsystem* LockSubsystem = UGASDBInputLockSubsystem::Get(this))
+	{
+		for (FStepState& State : StepStates)
+		{
+			if (State.LockHandle.IsValid())
+			{
+				LockSubsystem->Unlock(State.LockHandle);
+				State.LockHandle.Reset();
+			}
+		}
+	}
+
+	for (FStepState& State : StepStates)
+	{
+		StopWaitingForForwardedInput(State);
+	}
+
+	Super::OnDestroy(bInOwnerFinished);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_RunTaskSequence::ResetPooledState()
+{
+	Steps.Reset();
+	StepStates.Reset();
+	Mode = EGASDBTaskSequenceMode::Sequence;
+	NextStepIndex = 0;
+	NumFinishedSteps = 0;
+	ForwardingComponent = nullptr;
+	bOwnerFinished = false;
+}
+
+void UAbilityTask_RunTaskSequence::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	// Steps sit in an inline allocator, which cannot be a UPROPERTY, so their object references are reported here.
+	UAbilityTask_RunTaskSequence* This = CastChecked<UAbilityTask_RunTaskSequence>(InThis);
+	for (FGASDBTaskStep& Step : This->Steps)
+	{
+		Collector.AddPropertyReferencesWithStructARO(FGASDBTaskStep::StaticStruct(), &Step, This);
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
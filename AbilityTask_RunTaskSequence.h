@@ -0,0 +1,217 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "GASDBInputLockSubsystem.h"
+#include "InputTriggers.h"
+#include "AbilityTask_RunTaskSequence.generated.h"
+
+class APlayerController;
+class UGASDBInputForwardingComponent;
+class UInputAction;
+struct FInputActionValue;
+
+/** What a single step of a task sequence does */
+UENUM(BlueprintType)
+enum class EGASDBTaskStepType : uint8
+{
+	/** Lock controller input through the input lock subsystem; completes immediately */
+	LockInput UMETA(DisplayName = "Lock Input"),
+
+	/** Add movement input in a direction for a duration, like MoveInDirection */
+	MoveInDirection UMETA(DisplayName = "Move In Direction"),
+
+	/** Teleport the avatar, like InstantMoveToLocation; completes immediately */
+	InstantMove UMETA(DisplayName = "Instant Move"),
+
+	/** Spawn an actor with encroachment handling, like SpawnSafeActor; completes immediately (authority only) */
+	SpawnActor UMETA(DisplayName = "Spawn Actor"),
+
+	/** Wait for an Enhanced Input event from the input buffer. A server running a remote player's sequence waits for the press forwarded by the client's GASDBInputForwardingComponent. */
+	WaitInput UMETA(DisplayName = "Wait Input"),
+
+	/** Wait for a number of seconds */
+	WaitTime UMETA(DisplayName = "Wait Time")
+};
+
+/** Whether the steps run one after another or all at once */
+UENUM(BlueprintType)
+enum class EGASDBTaskSequenceMode : uint8
+{
+	Sequence,
+	Parallel
+};
+
+/** One step of a task sequence. Only the fields used by Type are read. */
+USTRUCT(BlueprintType)
+struct FGASDBTaskStep
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step")
+	EGASDBTaskStepType Type = EGASDBTaskStepType::WaitTime;
+
+	/** LockInput: lock duration, 0 holds it until the sequence ends. MoveInDirection / WaitTime: duration. WaitInput: timeout, 0 waits forever. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step", meta = (ClampMin = "0"))
+	float Duration = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Lock", meta = (Bitmask, BitmaskEnum = "/Script/LyraGame.EGASDBInputLockChannel", EditCondition = "Type == EGASDBTaskStepType::LockInput", EditConditionHides))
+	int32 LockChannels = static_cast<int32>(EGASDBInputLockChannel::All);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Move", meta = (EditCondition = "Type == EGASDBTaskStepType::MoveInDirection", EditConditionHides))
+	FVector Direction = FVector::ForwardVector;
+
+	/** Seconds between movement inputs; 0 adds input every tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Move", meta = (ClampMin = "0", EditCondition = "Type == EGASDBTaskStepType::MoveInDirection", EditConditionHides))
+	float Interval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Transform", meta = (EditCondition = "Type == EGASDBTaskStepType::InstantMove || Type == EGASDBTaskStepType::SpawnActor", EditConditionHides))
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Transform", meta = (EditCondition = "Type == EGASDBTaskStepType::InstantMove || Type == EGASDBTaskStepType::SpawnActor", EditConditionHides))
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Teleport", meta = (EditCondition = "Type == EGASDBTaskStepType::InstantMove", EditConditionHides))
+	bool bSweep = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Teleport", meta = (EditCondition = "Type == EGASDBTaskStepType::InstantMove", EditConditionHides))
+	bool bStopAtCollision = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Teleport", meta = (EditCondition = "Type == EGASDBTaskStepType::InstantMove", EditConditionHides))
+	bool bSetRotation = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Spawn", meta = (EditCondition = "Type == EGASDBTaskStepType::SpawnActor", EditConditionHides))
+	TSubclassOf<AActor> ActorClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Spawn", meta = (EditCondition = "Type == EGASDBTaskStepType::SpawnActor", EditConditionHides))
+	bool bMoveEncroachingActors = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Input", meta = (EditCondition = "Type == EGASDBTaskStepType::WaitInput", EditConditionHides))
+	TObjectPtr<UInputAction> InputAction = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Input", meta = (EditCondition = "Type == EGASDBTaskStepType::WaitInput", EditConditionHides))
+	ETriggerEvent TriggerEvent = ETriggerEvent::Triggered;
+
+	/** Input received up to this many seconds before the step started also counts */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Step|Input", meta = (ClampMin = "0", EditCondition = "Type == EGASDBTaskStepType::WaitInput", EditConditionHides))
+	float LookbackWindow = 0.1f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTaskSequenceStepDelegate, int32, StepIndex);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTaskSequenceActorSpawnedDelegate, int32, StepIndex, AActor*, SpawnedActor);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FTaskSequenceCompletedDelegate);
+
+/**
+ * Runs a declared list of GASDB steps (lock, move, teleport, spawn, wait-input, wait-time) inside a single ticking task.
+ * Step parameters and state live in inline buffers, so a sequence of up to InlineStepCount steps costs one task object
+ * and one tick registration instead of one task, timer and set of delegate bindings per step.
+ */
+UCLASS()
+class LYRAGAME_API UAbilityTask_RunTaskSequence : public UAbilityTask
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 InlineStepCount = 8;
+
+	UAbilityTask_RunTaskSequence(const FObjectInitializer& ObjectInitializer);
+
+	/** Called when a step finishes successfully */
+	UPROPERTY(BlueprintAssignable)
+	FTaskSequenceStepDelegate OnStepCompleted;
+
+	/** Called for every actor a SpawnActor step spawned */
+	UPROPERTY(BlueprintAssignable)
+	FTaskSequenceActorSpawnedDelegate OnActorSpawned;
+
+	/** Called when every step has finished */
+	UPROPERTY(BlueprintAssignable)
+	FTaskSequenceCompletedDelegate OnCompleted;
+
+	/** Called when a step fails (blocked teleport, failed spawn, input timeout, no way to receive input); the sequence stops there */
+	UPROPERTY(BlueprintAssignable)
+	FTaskSequenceStepDelegate OnFailed;
+
+	/**
+	 * Runs the given steps inside one task.
+	 * @param OwningAbility	The ability that owns this task.
+	 * @param Steps			The steps to run.
+	 * @param Mode			Sequence runs each step after the previous one finished, Parallel starts them all at once.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ability|Tasks", meta = (HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "TRUE"))
+	static UAbilityTask_RunTaskSequence* RunTaskSequence(UGameplayAbility* OwningAbility, FName TaskInstanceName, const TArray<FGASDBTaskStep>& Steps, EGASDBTaskSequenceMode Mode = EGASDBTaskSequenceMode::Sequence);
+
+	virtual void Activate() override;
+	virtual void TickTask(float DeltaTime) override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+protected:
+	virtual void OnDestroy(bool bInOwnerFinished) override;
+
+private:
+	friend class UGASDBAbilityTaskPool;
+
+	/** Restores constructor defaults before the task is reused from the pool */
+	void ResetPooledState();
+
+	enum class EStepStatus : uint8
+	{
+		Pending,
+		Running,
+		Succeeded,
+		Failed
+	};
+
+	/** Per-step runtime state, kept next to the step parameters */
+	struct FStepState
+	{
+		EStepStatus Status = EStepStatus::Pending;
+		float Elapsed = 0.f;
+		float TimeSinceMoveInput = 0.f;
+		double StartTime = 0.0;
+
+		/** Lock held until the sequence ends; released in OnDestroy */
+		FGASDBInputLockHandle LockHandle;
+
+		/** WaitInput on the server for a remote player: receiver for the input forwarded by the client */
+		FDelegateHandle ForwardingReceiverHandle;
+
+		bool bForwardedInputReceived = false;
+	};
+
+	/** Starts a step; instant steps finish inside this call */
+	void StartStep(int32 StepIndex);
+
+	/** Advances a running step by DeltaTime */
+	void TickStep(int32 StepIndex, float DeltaTime);
+
+	void FinishStep(int32 StepIndex, bool bSucceeded);
+
+	/** Starts the next pending step in Sequence mode and ends the task once every step is done */
+	void AdvanceSequence();
+
+	/** True once the input for a WaitInput step has arrived, buffered locally or forwarded by the client */
+	bool PollInput(const FGASDBTaskStep& Step, const FStepState& State, FInputActionValue& OutValue) const;
+
+	/** Finishes a WaitInput step; an owning client without authority also sends the press to the server */
+	void CompleteWaitInput(int32 StepIndex, const FInputActionValue& Value);
+
+	void ForwardedInputReceived(TConstArrayView<FInputActionValue> Values, bool bIsFinalState, int32 StepIndex);
+
+	void StopWaitingForForwardedInput(FStepState& State);
+
+	APlayerController* GetPlayerController() const;
+
+	TArray<FGASDBTaskStep, TInlineAllocator<InlineStepCount>> Steps;
+
+	TArray<FStepState, TInlineAllocator<InlineStepCount>> StepStates;
+
+	EGASDBTaskSequenceMode Mode = EGASDBTaskSequenceMode::Sequence;
+
+	int32 NextStepIndex = 0;
+
+	int32 NumFinishedSteps = 0;
+
+	TWeakObjectPtr<UGASDBInputForwardingComponent> ForwardingComponent;
+};
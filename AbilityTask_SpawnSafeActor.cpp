@@ -7,6 +7,12 @@
 #include "WorldCollision.h"
 #include "Engine/World.h"
 #include "Engine/Engine.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBDebug.h"
+#include "GASDBLatencyTracer.h"
+#include "GASDBTaskBudgetSubsystem.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
 
 UAbilityTask_SpawnSafeActor::UAbilityTask_SpawnSafeActor(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -18,7 +24,7 @@ UAbilityTask_SpawnSafeActor* UAbilityTask_SpawnSafeActor::SpawnSafeActor(
     FRotator Rotation, bool bMoveEncroachingActors
 )
 {
-    UAbilityTask_SpawnSafeActor* MyTask = NewAbilityTask<UAbilityTask_SpawnSafeActor>(OwningAbility, TaskInstanceName);
+    UAbilityTask_SpawnSafeActor* MyTask = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_SpawnSafeActor>(OwningAbility, TaskInstanceName);
     MyTask->MyActorClass = ActorClass;
     MyTask->CachedSpawnLocation = Location;  
     MyTask->CachedSpawnRotation = Rotation;
@@ -28,8 +34,20 @@ UAbilityTask_SpawnSafeActor* UAbilityTask_SpawnSafeActor::SpawnSafeActor(
 
 void UAbilityTask_SpawnSafeActor::Activate()
 {
+    GASDB_SCOPE(SpawnSafeActor_Activate);
+
+    UGASDBTaskBudgetSubsystem* Budget = UGASDBTaskBudgetSubsystem::GetIfEnabled(this);
+    if (Budget && Budget->TryDeferActivation(this, EGASDBTaskBudgetCategory::Placement, FSimpleDelegate::CreateUObject(this, &UAbilityTask_SpawnSafeActor::Activate)))
+    {
+        return;
+    }
+    GASDB_BUDGET_SCOPE(Placement);
+
     Super::Activate();
 
+    GASDB_LATENCY_STAGE(Ability, TaskActivated);
+    GASDB_RECORD(RecordSpawnSafeActor(this, MyActorClass.Get(), CachedSpawnLocation, CachedSpawnRotation, bMoveEncroachingActors));
+
     AActor* SpawnedActor = nullptr;
     if (BeginSpawningActor(Ability, MyActorClass, CachedSpawnLocation, CachedSpawnRotation, SpawnedActor))
     {
@@ -38,11 +56,28 @@ void UAbilityTask_SpawnSafeActor::Activate()
     else
     {
         // If spawning failed, broadcast failure and end the task.
+        GASDB_LATENCY_DISCARD(Ability);
         DidNotSpawn.Broadcast(nullptr);
         EndTask();
     }
 }
 
+void UAbilityTask_SpawnSafeActor::OnDestroy(bool bInOwnerFinished)
+{
+    Super::OnDestroy(bInOwnerFinished);
+
+    UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_SpawnSafeActor::ResetPooledState()
+{
+    MyActorClass = nullptr;
+    CachedSpawnLocation = FVector::ZeroVector;
+    CachedSpawnRotation = FRotator::ZeroRotator;
+    bMoveEncroachingActors = false;
+    bOwnerFinished = false;
+}
+
 bool UAbilityTask_SpawnSafeActor::BeginSpawningActor(UGameplayAbility* OwningAbility, TSubclassOf<AActor> ActorClass, FVector Location, FRotator Rotation, AActor*& SpawnedActor)
 {
     // Only proceed on the network authority.
@@ -72,16 +107,21 @@ void UAbilityTask_SpawnSafeActor::FinishSpawningActor(UGameplayAbility* OwningAb
         FTransform SpawnTransform(Rotation, Location);
         TArray<AActor*> EncroachingActors;
         // Try to resolve encroachment. If bMoveEncroachingActors is false, this simply checks for overlaps.
-        if (ResolveEncroachment(SpawnedActor, SpawnTransform, EncroachingActors))
+        const bool bEncroachmentResolved = ResolveEncroachment(SpawnedActor, SpawnTransform, EncroachingActors);
+        GASDB_LATENCY_STAGE(Ability, SceneQueryDone);
+
+        if (bEncroachmentResolved)
         {
             OnPreFinishSpawning.Broadcast(SpawnedActor);  
             SpawnedActor->FinishSpawning(SpawnTransform);
+            GASDB_LATENCY_STAGE(Ability, EffectApplied);
             Success.Broadcast(SpawnedActor);
         }
         else
         {
             // Encroachment could not be resolved; clean up the spawned actor.
             SpawnedActor->Destroy();
+            GASDB_LATENCY_DISCARD(Ability);
             DidNotSpawn.Broadcast(nullptr);
         }
     }
@@ -97,14 +137,54 @@ void UAbilityTask_SpawnSafeActor::GetEncroachingActors(AActor* ActorToSpawn, con
 
 bool UAbilityTask_SpawnSafeActor::HasEncroachment(AActor* ActorToCheck, const FTransform& Transform) const
 {
+    return HasEncroachmentAt(GetWorld(), ActorToCheck, Transform);
+}
+
+bool UAbilityTask_SpawnSafeActor::ResolveEncroachment(
+    AActor* ActorToSpawn,
+    const FTransform& SpawnTransform,
+    TArray<AActor*>& OutEncroachingActors
+) const
+{
+    return ResolveEncroachmentAt(GetWorld(), ActorToSpawn, SpawnTransform, bMoveEncroachingActors, OutEncroachingActors);
+}
+
+AActor* UAbilityTask_SpawnSafeActor::SpawnActorSafely(UWorld* World, TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform, bool bInMoveEncroachingActors)
+{
+    if (!World || !ActorClass)
+    {
+        return nullptr;
+    }
+
+    AActor* SpawnedActor = World->SpawnActorDeferred<AActor>(ActorClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+    if (!SpawnedActor)
+    {
+        return nullptr;
+    }
+
+    TArray<AActor*> EncroachingActors;
+    if (!ResolveEncroachmentAt(World, SpawnedActor, SpawnTransform, bInMoveEncroachingActors, EncroachingActors))
+    {
+        SpawnedActor->Destroy();
+        return nullptr;
+    }
+
+    SpawnedActor->FinishSpawning(SpawnTransform);
+    return SpawnedActor;
+}
+
+bool UAbilityTask_SpawnSafeActor::HasEncroachmentAt(UWorld* World, AActor* ActorToCheck, const FTransform& Transform)
+{
+    GASDB_SCOPE(SpawnSafeActor_EncroachmentQuery);
+
     TArray<FOverlapResult> Overlaps;
     FCollisionQueryParams Params(SCENE_QUERY_STAT(HasEncroachment), false, ActorToCheck);
-    UWorld* World = GetWorld();
     if (!World)
     {
         return false;
     }
-    
+
+    GASDB_COUNT_SCENE_QUERY();
     UPrimitiveComponent* RootComp = Cast<UPrimitiveComponent>(ActorToCheck->GetRootComponent());
     if (RootComp)
     {
@@ -133,25 +213,29 @@ bool UAbilityTask_SpawnSafeActor::HasEncroachment(AActor* ActorToCheck, const FT
     }
 }
 
-bool UAbilityTask_SpawnSafeActor::ResolveEncroachment(
+bool UAbilityTask_SpawnSafeActor::ResolveEncroachmentAt(
+    UWorld* World,
     AActor* ActorToSpawn,
     const FTransform& SpawnTransform,
+    bool bInMoveEncroachingActors,
     TArray<AActor*>& OutEncroachingActors
-) const
+)
 {
-    if (!ActorToSpawn || !GetWorld())
+    GASDB_SCOPE(SpawnSafeActor_ResolveEncroachment);
+
+    if (!ActorToSpawn || !World)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ResolveEncroachment: Invalid actor or world."));
+        GASDB_LOG(World, Warning, TEXT("ResolveEncroachment: Invalid actor or world."));
         return false;
     }
 
     // First, check if any overlaps exist at the desired spawn location.
-    if (HasEncroachment(ActorToSpawn, SpawnTransform))
+    if (HasEncroachmentAt(World, ActorToSpawn, SpawnTransform))
     {
         // If we're not allowed to move encroaching actors, then we fail immediately.
-        if (!bMoveEncroachingActors)
+        if (!bInMoveEncroachingActors)
         {
-            UE_LOG(LogTemp, Warning, TEXT("ResolveEncroachment: Overlap detected and bMoveEncroachingActors is false."));
+            GASDB_LOG(World, Warning, TEXT("ResolveEncroachment: Overlap detected and bMoveEncroachingActors is false."));
             return false;
         }
     }
@@ -166,14 +250,15 @@ bool UAbilityTask_SpawnSafeActor::ResolveEncroachment(
     if (!RootComp)
     {
         // Without a primitive component, we cannot adjust accurately.
-        UE_LOG(LogTemp, Warning, TEXT("ResolveEncroachment: Actor lacks a primitive root component for collision adjustment."));
+        GASDB_LOG(World, Warning, TEXT("ResolveEncroachment: Actor lacks a primitive root component for collision adjustment."));
         return false;
     }
 
     FCollisionShape CollisionShape = RootComp->GetCollisionShape();
     TArray<FOverlapResult> Overlaps;
     FCollisionQueryParams Params(SCENE_QUERY_STAT(ResolveEncroachment), false, ActorToSpawn);
-    GetWorld()->OverlapMultiByObjectType(
+    GASDB_COUNT_SCENE_QUERY();
+    World->OverlapMultiByObjectType(
         Overlaps,
         SpawnTransform.GetLocation(),
         SpawnTransform.GetRotation(),
@@ -200,6 +285,7 @@ bool UAbilityTask_SpawnSafeActor::ResolveEncroachment(
         }
 
         FMTDResult MTDResult;
+        GASDB_COUNT_SCENE_QUERY();
         if (PrimComp->GetBodyInstance()->OverlapTest(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), CollisionShape, &MTDResult))
         {
             TotalAdjustment += MTDResult.Direction * MTDResult.Distance;
@@ -212,7 +298,7 @@ bool UAbilityTask_SpawnSafeActor::ResolveEncroachment(
 
     // Create a new transform based on the adjusted location.
     FTransform AdjustedTransform = ActorToSpawn->GetTransform();
-    if (!HasEncroachment(ActorToSpawn, AdjustedTransform))
+    if (!HasEncroachmentAt(World, ActorToSpawn, AdjustedTransform))
     {
         return true; // Z adjustment resolved the issue.
     }
@@ -223,10 +309,10 @@ bool UAbilityTask_SpawnSafeActor::ResolveEncroachment(
 
     // Re-check for any remaining encroachment.
     AdjustedTransform = ActorToSpawn->GetTransform();
-    bool bResolved = !HasEncroachment(ActorToSpawn, AdjustedTransform);
+    bool bResolved = !HasEncroachmentAt(World, ActorToSpawn, AdjustedTransform);
     if (!bResolved)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ResolveEncroachment: Unable to fully resolve overlaps after adjustments."));
+        GASDB_LOG(World, Warning, TEXT("ResolveEncroachment: Unable to fully resolve overlaps after adjustments."));
     }
     return bResolved;
 }
@@ -41,7 +41,12 @@ public:
 
     virtual void Activate() override;
 
+    // Spawns and encroachment-checks an actor the same way this task does, without a task. Returns null on failure.
+    static AActor* SpawnActorSafely(UWorld* World, TSubclassOf<AActor> ActorClass, const FTransform& SpawnTransform, bool bInMoveEncroachingActors);
+
 protected:
+    virtual void OnDestroy(bool bInOwnerFinished) override;
+
     // Internal functions to handle the spawning and encroachment
     bool BeginSpawningActor(UGameplayAbility* OwningAbility, TSubclassOf<AActor> ActorClass, FVector Location, FRotator Rotation, AActor*& SpawnedActor);
     void FinishSpawningActor(UGameplayAbility* OwningAbility, FVector Location, FRotator Rotation, AActor* SpawnedActor);
@@ -55,9 +60,19 @@ protected:
     // Helper function to simply check for overlaps (without moving the actor)
     bool HasEncroachment(AActor* ActorToCheck, const FTransform& Transform) const;
 
+    // World-based versions of the above, shared with SpawnActorSafely
+    static bool ResolveEncroachmentAt(UWorld* World, AActor* ActorToSpawn, const FTransform& SpawnTransform, bool bInMoveEncroachingActors, TArray<AActor*>& OutEncroachingActors);
+    static bool HasEncroachmentAt(UWorld* World, AActor* ActorToCheck, const FTransform& Transform);
+
     // Properties
     TSubclassOf<AActor> MyActorClass;
     FVector CachedSpawnLocation;
     FRotator CachedSpawnRotation;
     bool bMoveEncroachingActors;
+
+private:
+    friend class UGASDBAbilityTaskPool;
+
+    // Restores constructor defaults before the task is reused from the pool
+    void ResetPooledState();
 };
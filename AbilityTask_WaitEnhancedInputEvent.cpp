@@ -2,11 +2,19 @@
 
 
 #include "AbilityTask_WaitEnhancedInputEvent.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBEventBatchSubsystem.h"
+#include "GASDBInputBufferSubsystem.h"
+#include "GASDBInputForwardingComponent.h"
+#include "GASDBLatencyTracer.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
+#include "HAL/PlatformTime.h"
 
 
 UAbilityTask_WaitEnhancedInputEvent* UAbilityTask_WaitEnhancedInputEvent::WaitEnhancedInputEvent(UGameplayAbility* OwningAbility, const FName TaskInstanceName, UInputAction* InputAction, const ETriggerEvent TriggerEventType, const bool bShouldOnlyTriggerOnce)
 {
-	UAbilityTask_WaitEnhancedInputEvent* AbilityTask = NewAbilityTask<UAbilityTask_WaitEnhancedInputEvent>(OwningAbility, TaskInstanceName);
+	UAbilityTask_WaitEnhancedInputEvent* AbilityTask = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_WaitEnhancedInputEvent>(OwningAbility, TaskInstanceName);
 	
 	AbilityTask->InputAction = InputAction;
 	AbilityTask->EventType = TriggerEventType;
@@ -15,8 +23,39 @@ UAbilityTask_WaitEnhancedInputEvent* UAbilityTask_WaitEnhancedInputEvent::WaitEn
 	return AbilityTask;
 }
 
+UAbilityTask_WaitEnhancedInputEvent* UAbilityTask_WaitEnhancedInputEvent::WaitBufferedEnhancedInputEvent(UGameplayAbility* OwningAbility, const FName TaskInstanceName, UInputAction* InputAction, const ETriggerEvent TriggerEventType, const float LookbackWindow, const bool bShouldOnlyTriggerOnce)
+{
+	UAbilityTask_WaitEnhancedInputEvent* AbilityTask = WaitEnhancedInputEvent(OwningAbility, TaskInstanceName, InputAction, TriggerEventType, bShouldOnlyTriggerOnce);
+
+	AbilityTask->bUseInputBuffer = true;
+	AbilityTask->LookbackWindow = FMath::Max(LookbackWindow, 0.f);
+
+	return AbilityTask;
+}
+
+UAbilityTask_WaitEnhancedInputEvent* UAbilityTask_WaitEnhancedInputEvent::WaitEnhancedInputEventWithServerForwarding(UGameplayAbility* OwningAbility, const FName TaskInstanceName, UInputAction* InputAction, const ETriggerEvent TriggerEventType, const float ForwardingWindow, const bool bShouldOnlyTriggerOnce)
+{
+	UAbilityTask_WaitEnhancedInputEvent* AbilityTask = WaitEnhancedInputEvent(OwningAbility, TaskInstanceName, InputAction, TriggerEventType, bShouldOnlyTriggerOnce);
+
+	AbilityTask->bForwardToServer = true;
+	AbilityTask->ForwardingWindow = FMath::Max(ForwardingWindow, 0.f);
+
+	return AbilityTask;
+}
+
+UAbilityTask_WaitEnhancedInputEvent* UAbilityTask_WaitEnhancedInputEvent::WaitEnhancedInputEventBatched(UGameplayAbility* OwningAbility, const FName TaskInstanceName, UInputAction* InputAction, const ETriggerEvent TriggerEventType, const bool bShouldOnlyTriggerOnce)
+{
+	UAbilityTask_WaitEnhancedInputEvent* AbilityTask = WaitEnhancedInputEvent(OwningAbility, TaskInstanceName, InputAction, TriggerEventType, bShouldOnlyTriggerOnce);
+
+	AbilityTask->bBatchedDelivery = true;
+
+	return AbilityTask;
+}
+
 void UAbilityTask_WaitEnhancedInputEvent::Activate()
 {
+	GASDB_SCOPE(WaitEnhancedInputEvent_Activate);
+
 	Super::Activate();
 
 	if (!AbilitySystemComponent.Get() || !Ability || !InputAction.IsValid())
@@ -24,6 +63,14 @@ void UAbilityTask_WaitEnhancedInputEvent::Activate()
 		return;
 	}
 
+	if (FGASDBTaskRecorder::IsRecording())
+	{
+		const EGASDBRecordedInputMode RecordedMode = bUseInputBuffer ? EGASDBRecordedInputMode::Buffered
+			: bForwardToServer ? EGASDBRecordedInputMode::ServerForwarding : EGASDBRecordedInputMode::Direct;
+		FGASDBTaskRecorder::Get().RecordWaitEnhancedInputEvent(this, InputAction.Get(), EventType, RecordedMode,
+			bUseInputBuffer ? LookbackWindow : ForwardingWindow, bTriggerOnce);
+	}
+
 	const APawn* const AvatarPawn = Cast<APawn>(Ability->GetAvatarActorFromActorInfo());
 	const APlayerController* const PlayerController = AvatarPawn ? Cast<APlayerController>(AvatarPawn->GetController()) : nullptr;
 	
@@ -32,6 +79,28 @@ void UAbilityTask_WaitEnhancedInputEvent::Activate()
 		return;
 	}
 
+	if (bForwardToServer)
+	{
+		ForwardingComponent = UGASDBInputForwardingComponent::FindForController(PlayerController);
+
+		// On the server, input for a remote player only ever arrives through the forwarding component.
+		if (ForwardingComponent.IsValid() && !PlayerController->IsLocalController())
+		{
+			if (IsForRemoteClient())
+			{
+				ForwardingReceiverHandle = ForwardingComponent->RegisterReceiver(GetAbilitySpecHandle(), InputAction.Get(), EventType,
+					FGASDBOnForwardedInput::CreateUObject(this, &UAbilityTask_WaitEnhancedInputEvent::ForwardedEventsReceived));
+			}
+			return;
+		}
+	}
+
+	if (bUseInputBuffer)
+	{
+		ActivateFromInputBuffer(PlayerController);
+		return;
+	}
+
 	EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerController->InputComponent);
 			
 	if (IsValid(EnhancedInputComponent.Get()))
@@ -40,16 +109,99 @@ void UAbilityTask_WaitEnhancedInputEvent::Activate()
 	}
 }
 
+void UAbilityTask_WaitEnhancedInputEvent::ActivateFromInputBuffer(const APlayerController* PlayerController)
+{
+	UGASDBInputBufferSubsystem* InputBuffer = UGASDBInputBufferSubsystem::Get(PlayerController);
+	if (!InputBuffer)
+	{
+		return;
+	}
+
+	BufferedController = PlayerController;
+	BufferListenerHandle = InputBuffer->RegisterListener(PlayerController, InputAction.Get(), EventType,
+		FGASDBOnBufferedInputBatch::CreateUObject(this, &UAbilityTask_WaitEnhancedInputEvent::BufferedEventsReceived));
+
+	// Presses that landed before this task was activated (e.g. between two combo steps).
+	TArray<FGASDBBufferedInputEvent> RecentEvents;
+	InputBuffer->ConsumeEvents(PlayerController, InputAction.Get(), EventType, LookbackWindow, RecentEvents, true, bTriggerOnce ? 1 : MAX_int32);
+	if (RecentEvents.Num() > 0)
+	{
+		BufferedEventsReceived(RecentEvents);
+	}
+}
+
+int32 UAbilityTask_WaitEnhancedInputEvent::BufferedEventsReceived(const TConstArrayView<FGASDBBufferedInputEvent> Events)
+{
+	int32 NumHandled = 0;
+	for (const FGASDBBufferedInputEvent& Event : Events)
+	{
+		if (bTriggerOnce && bHasBeenTriggered)
+		{
+			break;
+		}
+
+		HandleInputValue(Event.Value, Event.Timestamp);
+		++NumHandled;
+	}
+	return NumHandled;
+}
+
 void UAbilityTask_WaitEnhancedInputEvent::EventReceived(const FInputActionValue& Value)
 {
+	HandleInputValue(Value, FPlatformTime::Seconds());
+}
+
+void UAbilityTask_WaitEnhancedInputEvent::HandleInputValue(const FInputActionValue& Value, const double InputTimestamp)
+{
+	GASDB_SCOPE(WaitEnhancedInputEvent_Input);
+
 	if (bTriggerOnce && bHasBeenTriggered)
 	{
 		return;
 	}
 
 	bHasBeenTriggered = true;
-	
-	InputEventReceived.Broadcast(Value);
+	GASDB_RECORD(RecordInputValue(this, Value));
+
+	LatencyCorrelationId = FGASDBLatencyTracer::IsEnabled() ? static_cast<int32>(FGASDBLatencyTracer::Get().BeginTrace(Ability, InputTimestamp)) : 0;
+
+	// Only an owning client without authority needs to tell the server; a listen server host already is the server.
+	if (bForwardToServer && ForwardingComponent.IsValid() && !IsForRemoteClient() && !Ability->GetCurrentActorInfo()->IsNetAuthority())
+	{
+		ForwardingComponent->QueueInput(GetAbilitySpecHandle(), InputAction.Get(), EventType, Value, ForwardingWindow);
+		LastForwardedValue = Value;
+		bHasForwardedValue = true;
+	}
+
+	UGASDBEventBatchSubsystem* EventBatch = bBatchedDelivery ? UGASDBEventBatchSubsystem::GetIfBatching(this) : nullptr;
+	if (!EventBatch || !EventBatch->QueueInputEvent(this, Value, LatencyCorrelationId))
+	{
+		InputEventReceived.Broadcast(Value);
+	}
+}
+
+void UAbilityTask_WaitEnhancedInputEvent::ForwardedEventsReceived(const TConstArrayView<FInputActionValue> Values, const bool bIsFinalState)
+{
+	GASDB_SCOPE(WaitEnhancedInputEvent_ForwardedInput);
+
+	// The final state repeats the last value the client saw; it only carries news if the unreliable batch with that value was lost.
+	if (bIsFinalState && Values.Num() > 0 && bHasReceivedForwardedValue
+		&& Values.Last().GetValueType() == LastReceivedValue.GetValueType() && Values.Last().Get<FVector>() == LastReceivedValue.Get<FVector>())
+	{
+		return;
+	}
+
+	for (const FInputActionValue& Value : Values)
+	{
+		if (bTriggerOnce && bHasBeenTriggered)
+		{
+			return;
+		}
+
+		LastReceivedValue = Value;
+		bHasReceivedForwardedValue = true;
+		EventReceived(Value);
+	}
 }
 
 void UAbilityTask_WaitEnhancedInputEvent::OnDestroy(const bool bInOwnerFinished)
@@ -58,6 +210,55 @@ void UAbilityTask_WaitEnhancedInputEvent::OnDestroy(const bool bInOwnerFinished)
 	{
 		EnhancedInputComponent->ClearBindingsForObject(this);
 	}
+
+	if (BufferListenerHandle.IsValid())
+	{
+		if (UGASDBInputBufferSubsystem* InputBuffer = UGASDBInputBufferSubsystem::Get(this))
+		{
+			InputBuffer->UnregisterListener(BufferedController.Get(), BufferListenerHandle);
+		}
+		BufferListenerHandle.Reset();
+	}
+
+	if (UGASDBInputForwardingComponent* Forwarding = ForwardingComponent.Get())
+	{
+		if (ForwardingReceiverHandle.IsValid())
+		{
+			Forwarding->UnregisterReceiver(ForwardingReceiverHandle);
+			ForwardingReceiverHandle.Reset();
+		}
+		else if (bHasForwardedValue)
+		{
+			Forwarding->SendFinalState(GetAbilitySpecHandle(), InputAction.Get(), EventType, LastForwardedValue);
+			bHasForwardedValue = false;
+		}
+	}
 	
 	Super::OnDestroy(bInOwnerFinished);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_WaitEnhancedInputEvent::ResetPooledState()
+{
+	EnhancedInputComponent = nullptr;
+	InputAction = nullptr;
+	EventType = ETriggerEvent::None;
+	bTriggerOnce = true;
+	bHasBeenTriggered = false;
+	bUseInputBuffer = false;
+	LookbackWindow = 0.f;
+	BufferedController = nullptr;
+	BufferListenerHandle.Reset();
+	bForwardToServer = false;
+	bBatchedDelivery = false;
+	ForwardingWindow = 0.f;
+	ForwardingComponent = nullptr;
+	ForwardingReceiverHandle.Reset();
+	bHasForwardedValue = false;
+	LastForwardedValue = FInputActionValue();
+	bHasReceivedForwardedValue = false;
+	LastReceivedValue = FInputActionValue();
+	LatencyCorrelationId = 0;
+	bOwnerFinished = false;
 }
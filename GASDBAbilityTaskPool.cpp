@@ -0,0 +1,226 @@
+#include "GASDBAbilityTaskPool.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GASDBTaskBudgetSubsystem.h"
+#include "GASDBTaskRecording.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UnrealType.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBAbilityTaskPool)
+
+namespace GASDBTaskPool
+{
+	static bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("gasdb.TaskPool.Enable"),
+		bEnabled,
+		TEXT("Reuse GASDB ability task objects after they end instead of creating a new UObject per activation."),
+		ECVF_Default);
+
+	static int32 MaxPerClass = 64;
+	static FAutoConsoleVariableRef CVarMaxPerClass(
+		TEXT("gasdb.TaskPool.MaxPerClass"),
+		MaxPerClass,
+		TEXT("Maximum number of idle task objects kept per task class."),
+		ECVF_Default);
+}
+
+UGASDBAbilityTaskPool* UGASDBAbilityTaskPool::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UGASDBAbilityTaskPool>() : nullptr;
+}
+
+bool UGASDBAbilityTaskPool::IsEnabled()
+{
+	return GASDBTaskPool::bEnabled;
+}
+
+UAbilityTask* UGASDBAbilityTaskPool::Acquire(UClass* TaskClass)
+{
+	FGASDBAbilityTaskPoolBucket& Bucket = Buckets.FindOrAdd(TaskClass);
+	while (Bucket.FreeTasks.Num() > 0)
+	{
+		UAbilityTask* Task = Bucket.FreeTasks.Pop(EAllowShrinking::No);
+		if (!IsValid(Task))
+		{
+			continue;
+		}
+
+		// Release unbinds everything; anything bound now was added to a task that was already back in the pool.
+		const int32 StaleBindings = ClearDynamicDelegates(Task);
+		if (!ensureMsgf(StaleBindings == 0, TEXT("%s taken from the pool with %d delegate(s) still bound"), *Task->GetName(), StaleBindings))
+		{
+			Bucket.NumStaleBindingsOnReuse += StaleBindings;
+		}
+
+		++Bucket.NumReused;
+		return Task;
+	}
+
+	++Bucket.NumCreated;
+	return nullptr;
+}
+
+void UGASDBAbilityTaskPool::ReleaseTask(UAbilityTask* Task, void (*ResetPooledState)(UAbilityTask*))
+{
+	if (!Task)
+	{
+		return;
+	}
+
+	FGASDBTaskMetrics::Get().NoteTaskEnded(Task);
+	GASDB_RECORD(RecordTaskEnded(Task));
+
+	if (UGASDBTaskBudgetSubsystem* Budget = UGASDBTaskBudgetSubsystem::GetIfEnabled(Task))
+	{
+		Budget->ForgetTask(Task);
+	}
+
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	// Callers further up the stack may still use the task this frame, so it is only recycled at the end of the frame.
+	if (UGASDBAbilityTaskPool* Pool = Get())
+	{
+		Pool->PendingReleases.Add({ Task, ResetPooledState });
+	}
+}
+
+void UGASDBAbilityTaskPool::ReleasePendingTasks()
+{
+	if (PendingReleases.Num() == 0)
+	{
+		return;
+	}
+
+	// ResetPooledState could in principle end another task; anything released meanwhile waits for the next frame.
+	TArray<FGASDBPendingTaskRelease> Releasing = MoveTemp(PendingReleases);
+	for (const FGASDBPendingTaskRelease& Pending : Releasing)
+	{
+		if (Pending.Task)
+		{
+			ReleaseInternal(Pending.Task, Pending.ResetPooledState);
+		}
+	}
+}
+
+bool UGASDBAbilityTaskPool::ReleaseInternal(UAbilityTask* Task, void (*ResetPooledState)(UAbilityTask*))
+{
+	FGASDBAbilityTaskPoolBucket& Bucket = Buckets.FindOrAdd(Task->GetClass());
+	if (Bucket.FreeTasks.Contains(Task))
+	{
+		return false;
+	}
+
+	// Replicated simulated tasks keep a net identity on clients; reusing the object would alias two tasks there.
+	const UWorld* World = Task->GetWorld();
+	const bool bIsNetworkedSimulatedTask = Task->IsSimulatedTask() && (!World || World->GetNetMode() != NM_Standalone);
+
+	if (bIsNetworkedSimulatedTask || Task->IsSimulating() || Bucket.FreeTasks.Num() >= GASDBTaskPool::MaxPerClass
+		|| Task->HasAnyFlags(RF_BeginDestroyed | RF_FinishDestroyed))
+	{
+		++Bucket.NumRejected;
+		return false;
+	}
+
+	// UGameplayTask::OnDestroy marked the task as garbage; take it back from the collector.
+	Task->ClearGarbage();
+
+	// An idle task must not keep its ability, and through it the world, reachable. The next InitTask sets both again.
+	Task->Ability = nullptr;
+	Task->AbilitySystemComponent = nullptr;
+
+	Bucket.NumBindingsCleared += ClearDynamicDelegates(Task);
+	ResetPooledState(Task);
+	Bucket.FreeTasks.Add(Task);
+	++Bucket.NumReleased;
+	return true;
+}
+
+int32 UGASDBAbilityTaskPool::ClearDynamicDelegates(UAbilityTask* Task)
+{
+	int32 NumBound = 0;
+	for (TFieldIterator<FMulticastDelegateProperty> It(Task->GetClass()); It; ++It)
+	{
+		void* PropertyValue = It->ContainerPtrToValuePtr<void>(Task);
+		const FMulticastScriptDelegate* Delegate = It->GetMulticastDelegate(PropertyValue);
+		if (Delegate && Delegate->IsBound())
+		{
+			++NumBound;
+			It->ClearDelegate(Task, PropertyValue);
+		}
+	}
+	return NumBound;
+}
+
+void UGASDBAbilityTaskPool::Flush()
+{
+	for (TPair<TObjectPtr<UClass>, FGASDBAbilityTaskPoolBucket>& Pair : Buckets)
+	{
+		Pair.Value.FreeTasks.Reset();
+	}
+	PendingReleases.Reset();
+}
+
+void UGASDBAbilityTaskPool::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("GASDB task pool (%s, max %d per class, %d pending release)"), IsEnabled() ? TEXT("enabled") : TEXT("disabled"), GASDBTaskPool::MaxPerClass, PendingReleases.Num());
+	for (const TPair<TObjectPtr<UClass>, FGASDBAbilityTaskPoolBucket>& Pair : Buckets)
+	{
+		const FGASDBAbilityTaskPoolBucket& Bucket = Pair.Value;
+		Ar.Logf(TEXT("  %-40s idle=%-4d created=%-8llu reused=%-8llu released=%-8llu rejected=%-8llu bindingsCleared=%-8llu staleOnReuse=%llu"),
+			*GetNameSafe(Pair.Key), Bucket.FreeTasks.Num(), Bucket.NumCreated, Bucket.NumReused, Bucket.NumReleased,
+			Bucket.NumRejected, Bucket.NumBindingsCleared, Bucket.NumStaleBindingsOnReuse);
+	}
+}
+
+void UGASDBAbilityTaskPool::OnWorldCleanup(UWorld* World, const bool bSessionEnded, const bool bCleanupResources)
+{
+	// Released tasks no longer know their world, so drop them all, pending ones included; this also keeps tasks from being reused across PIE sessions or travel.
+	Flush();
+}
+
+void UGASDBAbilityTaskPool::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UGASDBAbilityTaskPool::OnWorldCleanup);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGASDBAbilityTaskPool::ReleasePendingTasks);
+}
+
+void UGASDBAbilityTaskPool::Deinitialize()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	WorldCleanupHandle.Reset();
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	Buckets.Reset();
+	PendingReleases.Reset();
+
+	Super::Deinitialize();
+}
+
+static FAutoConsoleCommandWithOutputDevice GASDBTaskPoolStatsCommand(
+	TEXT("gasdb.TaskPool.Stats"),
+	TEXT("Prints per-class GASDB task pool statistics."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		if (const UGASDBAbilityTaskPool* Pool = UGASDBAbilityTaskPool::Get())
+		{
+			Pool->DumpStats(Ar);
+		}
+	}));
+
+static FAutoConsoleCommand GASDBTaskPoolFlushCommand(
+	TEXT("gasdb.TaskPool.Flush"),
+	TEXT("Releases every idle pooled GASDB task to the garbage collector."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (UGASDBAbilityTaskPool* Pool = UGASDBAbilityTaskPool::Get())
+		{
+			Pool->Flush();
+		}
+	}));
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbility.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "GASDBTaskMetrics.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "GASDBAbilityTaskPool.generated.h"
+
+/** Free list and counters for one pooled task class. */
+USTRUCT()
+struct FGASDBAbilityTaskPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UAbilityTask>> FreeTasks;
+
+	/** Tasks created with NewObject because the free list was empty */
+	uint64 NumCreated = 0;
+
+	/** Tasks handed out from the free list */
+	uint64 NumReused = 0;
+
+	/** Tasks returned to the free list */
+	uint64 NumReleased = 0;
+
+	/** Tasks left to the garbage collector because the pool was full or the task could not be pooled */
+	uint64 NumRejected = 0;
+
+	/** Dynamic delegate bindings still present when a task was released, cleared before pooling */
+	uint64 NumBindingsCleared = 0;
+
+	/** Bindings found on a task taken from the free list; should always stay zero */
+	uint64 NumStaleBindingsOnReuse = 0;
+};
+
+/** A task that ended this frame and moves to its free list at the end of the frame. */
+USTRUCT()
+struct FGASDBPendingTaskRelease
+{
+	GENERATED_BODY()
+
+	/** Nulled by the collector if the task is destroyed before the end of the frame */
+	UPROPERTY()
+	TObjectPtr<UAbilityTask> Task = nullptr;
+
+	/** The task class's ResetPooledState */
+	void (*ResetPooledState)(UAbilityTask*) = nullptr;
+};
+
+/**
+ * Opt-in object pool for the GASDB ability tasks (gasdb.TaskPool.Enable 1).
+ *
+ * Task factories call NewPooledAbilityTask instead of NewAbilityTask. When a pooled task finishes, its OnDestroy hands
+ * it back via Release. The task stays untouched for the rest of the frame, so code still on the stack below OnDestroy
+ * and events batched during the frame see it as it was when it ended. At the end of the frame (FCoreDelegates::OnEndFrame)
+ * the garbage flag set by UGameplayTask::OnDestroy is cleared, every dynamic delegate is unbound, its ability references
+ * are dropped and the object waits on a per-class free list for the next activation. Callers must not keep references
+ * to a task past the frame it ended in when pooling is enabled, since the same object will be handed to a later
+ * activation. Pending and free tasks are dropped whenever a world is cleaned up, so idle tasks never keep a world
+ * reachable or move between worlds.
+ *
+ * Pooled task classes declare `friend class UGASDBAbilityTaskPool;` and implement `void ResetPooledState();` to put
+ * their own members, and UGameplayTask::bOwnerFinished, back to constructor defaults; it runs when the task enters the
+ * free list.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBAbilityTaskPool : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGASDBAbilityTaskPool* Get();
+
+	static bool IsEnabled();
+
+	/** Drop-in replacement for UAbilityTask::NewAbilityTask that reuses a pooled object when one is available. */
+	template <class T>
+	static T* NewPooledAbilityTask(UGameplayAbility* ThisAbility, FName InstanceName = FName())
+	{
+		UGASDBAbilityTaskPool* Pool = IsEnabled() ? Get() : nullptr;
+		if (!Pool)
+		{
+			T* MyObj = T::template NewAbilityTask<T>(ThisAbility, InstanceName);
+			FGASDBTaskMetrics::Get().NoteTaskCreated(MyObj);
+			return MyObj;
+		}
+
+		check(ThisAbility);
+
+		T* MyObj = CastChecked<T>(Pool->Acquire(T::StaticClass()), ECastCheckedType::NullAllowed);
+		if (!MyObj)
+		{
+			MyObj = NewObject<T>();
+		}
+
+		MyObj->InitTask(*ThisAbility, ThisAbility->GetGameplayTaskDefaultPriority());
+		UAbilityTask::DebugRecordAbilityTaskCreatedByAbility(ThisAbility);
+		MyObj->InstanceName = InstanceName;
+		FGASDBTaskMetrics::Get().NoteTaskCreated(MyObj);
+		return MyObj;
+	}
+
+	/**
+	 * Called at the end of a pooled task's OnDestroy, after Super::OnDestroy. Only updates the active task counters when
+	 * pooling is disabled; otherwise the task is queued and enters the free list at the end of the frame.
+	 */
+	template <class T>
+	static void Release(T* Task)
+	{
+		ReleaseTask(Task, &ResetTask<T>);
+	}
+
+	/** Moves the tasks released this frame to their free lists. Runs on FCoreDelegates::OnEndFrame; call it after each tick when ticking a world outside the engine loop. */
+	void ReleasePendingTasks();
+
+	/** Empties every free list and drops the pending releases, leaving the tasks to the garbage collector. Statistics are kept. */
+	void Flush();
+
+	void DumpStats(FOutputDevice& Ar) const;
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+private:
+	template <class T>
+	static void ResetTask(UAbilityTask* Task)
+	{
+		CastChecked<T>(Task)->ResetPooledState();
+	}
+
+	/** Non-template part of Release */
+	static void ReleaseTask(UAbilityTask* Task, void (*ResetPooledState)(UAbilityTask*));
+
+	/** Pops a task from the class's free list, or records a creation and returns null if it is empty. */
+	UAbilityTask* Acquire(UClass* TaskClass);
+
+	bool ReleaseInternal(UAbilityTask* Task, void (*ResetPooledState)(UAbilityTask*));
+
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** Unbinds every dynamic multicast delegate on the task. Returns the number of delegates that were bound. */
+	static int32 ClearDynamicDelegates(UAbilityTask* Task);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FGASDBAbilityTaskPoolBucket> Buckets;
+
+	UPROPERTY()
+	TArray<FGASDBPendingTaskRelease> PendingReleases;
+
+	FDelegateHandle WorldCleanupHandle;
+
+	FDelegateHandle EndFrameHandle;
+};
@@ -0,0 +1,377 @@
+#include "GASDBBenchmarkCommandlet.h"
+#include "AbilityTask_InstantMoveToLocation.h"
+#include "AbilityTask_MoveInDirection.h"
+#include "AbilityTask_MoveRandomly.h"
+#include "AbilityTask_OnTickEvent.h"
+#include "AbilityTask_RunTaskSequence.h"
+#include "AbilityTask_SpawnSafeActor.h"
+#include "Dom/JsonObject.h"
+#include "EngineUtils.h"
+#include "GASDBDebug.h"
+#include "GASDBTaskHarness.h"
+#include "GASDBTaskMetrics.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/UObjectArray.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBBenchmarkCommandlet)
+
+namespace GASDBBenchmark
+{
+	static constexpr float FrameDeltaSeconds = 1.f / 60.f;
+
+	/** Long enough that no ticking task ends on its own during a scenario */
+	static constexpr float EndlessDuration = 1.0e6f;
+
+	/** Process-wide FMalloc call counters. They are not kept in Shipping builds, where every count stays zero. */
+	struct FAllocCounts
+	{
+		uint64 NumMallocs = 0;
+		uint64 NumFrees = 0;
+
+		static FAllocCounts Capture()
+		{
+			FAllocCounts Counts;
+#if !UE_BUILD_SHIPPING
+			Counts.NumMallocs = FMalloc::TotalMallocCalls;
+			Counts.NumFrees = FMalloc::TotalFreeCalls;
+#endif
+			return Counts;
+		}
+	};
+
+	struct FSnapshot
+	{
+		int32 NumUObjects = 0;
+		uint64 NumSceneQueries = 0;
+
+		static FSnapshot Capture()
+		{
+			FSnapshot Snapshot;
+			Snapshot.NumUObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+			Snapshot.NumSceneQueries = FGASDBTaskMetrics::Get().NumSceneQueries;
+			return Snapshot;
+		}
+	};
+
+	static void ParseIntList(const FString& InList, TArray<int32>& OutValues)
+	{
+		TArray<FString> Entries;
+		InList.ParseIntoArray(Entries, TEXT(","));
+		for (const FString& Entry : Entries)
+		{
+			const int32 Value = FCString::Atoi(*Entry);
+			if (Value > 0)
+			{
+				OutValues.Add(Value);
+			}
+		}
+	}
+
+	static void WriteDeltas(FJsonObject& Result, const FSnapshot& Before, const FSnapshot& After, const FSnapshot& AfterGC, int32 NumActivations)
+	{
+		const uint64 SceneQueries = After.NumSceneQueries - Before.NumSceneQueries;
+		Result.SetNumberField(TEXT("scene_queries"), static_cast<double>(SceneQueries));
+		Result.SetNumberField(TEXT("scene_queries_per_activation"), NumActivations > 0 ? static_cast<double>(SceneQueries) / NumActivations : 0.0);
+		Result.SetNumberField(TEXT("uobject_delta"), After.NumUObjects - Before.NumUObjects);
+		Result.SetNumberField(TEXT("uobject_delta_after_gc"), AfterGC.NumUObjects - Before.NumUObjects);
+	}
+
+	/** Writes allocs_per_<Unit> and frees_per_<Unit> for the FMalloc calls between Start and End */
+	static double WriteAllocations(FJsonObject& Result, const TCHAR* Unit, const FAllocCounts& Start, const FAllocCounts& End, const double NumUnits)
+	{
+		const double AllocsPerUnit = NumUnits > 0.0 ? static_cast<double>(End.NumMallocs - Start.NumMallocs) / NumUnits : 0.0;
+		const double FreesPerUnit = NumUnits > 0.0 ? static_cast<double>(End.NumFrees - Start.NumFrees) / NumUnits : 0.0;
+		Result.SetNumberField(FString::Printf(TEXT("allocs_per_%s"), Unit), AllocsPerUnit);
+		Result.SetNumberField(FString::Printf(TEXT("frees_per_%s"), Unit), FreesPerUnit);
+		return AllocsPerUnit;
+	}
+}
+
+UGASDBBenchmarkCommandlet::UGASDBBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGASDBBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace GASDBBenchmark;
+
+	FString CountsString = TEXT("1,100,1000,10000");
+	FString BurstsString = TEXT("1,100,1000");
+	FString TasksString;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("GASDBBenchmark.json");
+	FParse::Value(*Params, TEXT("Counts="), CountsString);
+	FParse::Value(*Params, TEXT("Bursts="), BurstsString);
+	FParse::Value(*Params, TEXT("Tasks="), TasksString);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("Warmup="), NumWarmupFrames);
+	NumFrames = FMath::Max(1, NumFrames);
+	NumWarmupFrames = FMath::Max(0, NumWarmupFrames);
+
+	TArray<int32> Counts;
+	TArray<int32> Bursts;
+	ParseIntList(CountsString, Counts);
+	ParseIntList(BurstsString, Bursts);
+
+	TArray<FString> TaskFilter;
+	TasksString.ParseIntoArray(TaskFilter, TEXT(","));
+	auto IsSelected = [&TaskFilter](const TCHAR* TaskName)
+	{
+		return TaskFilter.Num() == 0 || TaskFilter.Contains(TaskName);
+	};
+
+	int32 MaxAvatars = 1;
+	for (const int32 Count : Counts)
+	{
+		MaxAvatars = FMath::Max(MaxAvatars, Count);
+	}
+	for (const int32 Burst : Bursts)
+	{
+		MaxAvatars = FMath::Max(MaxAvatars, Burst);
+	}
+
+	FGASDBTaskHarness Harness;
+	if (!Harness.Initialize())
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBBenchmark: could not create a world."));
+		return 1;
+	}
+
+	Harness.SpawnAvatars(MaxAvatars);
+	if (Harness.GetNumAvatars() < MaxAvatars)
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBBenchmark: spawned %d of %d avatars."), Harness.GetNumAvatars(), MaxAvatars);
+		return 1;
+	}
+
+	FMath::RandInit(0x6A5DB);
+
+	const double IdleFrameSeconds = MeasureIdleFrame(Harness);
+	UE_LOG(LogGASDB, Display, TEXT("GASDBBenchmark: %d avatars, idle frame %.3f ms"), MaxAvatars, IdleFrameSeconds * 1000.0);
+
+	struct FScenario
+	{
+		const TCHAR* TaskName;
+		FTaskFactory Factory;
+		bool bBurst;
+	};
+
+	const FScenario Scenarios[] =
+	{
+		{ TEXT("OnTickEvent"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				return UAbilityTask_OnTickEvent::OnTickEvent(OwningAbility, NAME_None);
+			}, false },
+		{ TEXT("MoveRandomly"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				return UAbilityTask_MoveRandomly::MoveRandomlyTask(OwningAbility, NAME_None, 0.5f, EndlessDuration);
+			}, false },
+		{ TEXT("MoveInDirection"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				return UAbilityTask_MoveInDirection::MoveInDirectionTask(OwningAbility, NAME_None, FVector::ForwardVector, 0.015f, EndlessDuration);
+			}, false },
+		{ TEXT("RunTaskSequence"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				TArray<FGASDBTaskStep> Steps;
+				FGASDBTaskStep& MoveStep = Steps.AddDefaulted_GetRef();
+				MoveStep.Type = EGASDBTaskStepType::MoveInDirection;
+				MoveStep.Duration = EndlessDuration;
+				return UAbilityTask_RunTaskSequence::RunTaskSequence(OwningAbility, NAME_None, Steps);
+			}, false },
+		{ TEXT("InstantMoveToLocation"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				const FVector Target = OwningAbility->GetAvatarActorFromActorInfo()->GetActorLocation() + FVector(0.f, 0.f, 10.f);
+				return UAbilityTask_InstantMoveToLocation::InstantMoveToLocation(OwningAbility, Target, FRotator::ZeroRotator, false, false);
+			}, true },
+		{ TEXT("InstantMoveToLocationSweep"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				const FVector Target = OwningAbility->GetAvatarActorFromActorInfo()->GetActorLocation() - FVector(0.f, 0.f, 10.f);
+				return UAbilityTask_InstantMoveToLocation::InstantMoveToLocation(OwningAbility, Target, FRotator::ZeroRotator, true, false);
+			}, true },
+		{ TEXT("SpawnSafeActor"), [](UGameplayAbility* OwningAbility, int32)
+			{
+				const FVector Location = OwningAbility->GetAvatarActorFromActorInfo()->GetActorLocation() + FVector(0.f, 0.f, 300.f);
+				return UAbilityTask_SpawnSafeActor::SpawnSafeActor(OwningAbility, NAME_None, AActor::StaticClass(), Location, FRotator::ZeroRotator, false);
+			}, true },
+	};
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	for (const FScenario& Scenario : Scenarios)
+	{
+		if (!IsSelected(Scenario.TaskName))
+		{
+			continue;
+		}
+
+		for (const int32 Count : Scenario.bBurst ? Bursts : Counts)
+		{
+			const TSharedRef<FJsonObject> Result = Scenario.bBurst
+				? RunBurstScenario(Harness, Scenario.TaskName, Scenario.Factory, Count)
+				: RunTickScenario(Harness, Scenario.TaskName, Scenario.Factory, Count, IdleFrameSeconds);
+			Results.Add(MakeShared<FJsonValueObject>(Result));
+		}
+	}
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("engine_version"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Root->SetNumberField(TEXT("avatars"), MaxAvatars);
+	Root->SetNumberField(TEXT("frames"), NumFrames);
+	Root->SetNumberField(TEXT("frame_delta_seconds"), FrameDeltaSeconds);
+	Root->SetNumberField(TEXT("idle_frame_ns"), IdleFrameSeconds * 1.0e9);
+	Root->SetArrayField(TEXT("results"), Results);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBBenchmark: could not write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDBBenchmark: wrote %d results to %s"), Results.Num(), *OutputPath);
+	return 0;
+}
+
+double UGASDBBenchmarkCommandlet::MeasureIdleFrame(FGASDBTaskHarness& Harness) const
+{
+	for (int32 Frame = 0; Frame < NumWarmupFrames; ++Frame)
+	{
+		Harness.TickWorld(GASDBBenchmark::FrameDeltaSeconds);
+	}
+
+	double TotalSeconds = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		TotalSeconds += Harness.TickWorld(GASDBBenchmark::FrameDeltaSeconds);
+	}
+	return TotalSeconds / NumFrames;
+}
+
+TSharedRef<FJsonObject> UGASDBBenchmarkCommandlet::RunTickScenario(FGASDBTaskHarness& Harness, const TCHAR* TaskName, const FTaskFactory& Factory, const int32 Count, const double IdleFrameSeconds)
+{
+	using namespace GASDBBenchmark;
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const FSnapshot Before = FSnapshot::Capture();
+
+	const FAllocCounts ActivationAllocsStart = FAllocCounts::Capture();
+	const double ActivationStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		UAbilityTask* Task = Factory(Harness.GetAbility(Index), Index);
+		Harness.TrackTask(Task);
+		Task->ReadyForActivation();
+	}
+	const double ActivationSeconds = FPlatformTime::Seconds() - ActivationStart;
+	const FAllocCounts ActivationAllocsEnd = FAllocCounts::Capture();
+
+	for (int32 Frame = 0; Frame < NumWarmupFrames; ++Frame)
+	{
+		Harness.TickWorld(FrameDeltaSeconds);
+	}
+
+	// Includes the idle world's own per-frame allocations, spread over the tasks.
+	const FAllocCounts TickAllocsStart = FAllocCounts::Capture();
+	double TotalFrameSeconds = 0.0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		TotalFrameSeconds += Harness.TickWorld(FrameDeltaSeconds);
+	}
+	const FAllocCounts TickAllocsEnd = FAllocCounts::Capture();
+
+	const int32 NumLiveTasks = Harness.GetNumLiveTrackedTasks();
+	const FSnapshot After = FSnapshot::Capture();
+
+	Harness.EndAllTasks();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const FSnapshot AfterGC = FSnapshot::Capture();
+
+	const double FrameSeconds = TotalFrameSeconds / NumFrames;
+	const double TaskTickNs = FMath::Max(0.0, FrameSeconds - IdleFrameSeconds) * 1.0e9 / Count;
+
+	const TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("task"), TaskName);
+	Result->SetStringField(TEXT("mode"), TEXT("tick"));
+	Result->SetNumberField(TEXT("count"), Count);
+	Result->SetNumberField(TEXT("live_tasks_at_end"), NumLiveTasks);
+	Result->SetNumberField(TEXT("frame_ns"), FrameSeconds * 1.0e9);
+	Result->SetNumberField(TEXT("ns_per_task_tick"), TaskTickNs);
+	Result->SetNumberField(TEXT("ns_per_activation"), ActivationSeconds * 1.0e9 / Count);
+	const double AllocsPerActivation = WriteAllocations(*Result, TEXT("activation"), ActivationAllocsStart, ActivationAllocsEnd, Count);
+	const double AllocsPerTick = WriteAllocations(*Result, TEXT("tick"), TickAllocsStart, TickAllocsEnd, static_cast<double>(NumFrames) * Count);
+	WriteDeltas(*Result, Before, After, AfterGC, Count);
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDBBenchmark: %-28s tick  count=%-6d frame=%.3f ms  task tick=%.1f ns  activation=%.1f ns  allocs/activation=%.2f  allocs/tick=%.2f"),
+		TaskName, Count, FrameSeconds * 1000.0, TaskTickNs, ActivationSeconds * 1.0e9 / Count, AllocsPerActivation, AllocsPerTick);
+	return Result;
+}
+
+TSharedRef<FJsonObject> UGASDBBenchmarkCommandlet::RunBurstScenario(FGASDBTaskHarness& Harness, const TCHAR* TaskName, const FTaskFactory& Factory, const int32 Count)
+{
+	using namespace GASDBBenchmark;
+
+	UWorld* World = Harness.GetWorld();
+	TSet<AActor*> ActorsBefore;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		ActorsBefore.Add(*It);
+	}
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const FSnapshot Before = FSnapshot::Capture();
+
+	// Instant tasks do all their work inside ReadyForActivation.
+	const FAllocCounts BurstAllocsStart = FAllocCounts::Capture();
+	const double BurstStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		UAbilityTask* Task = Factory(Harness.GetAbility(Index % Harness.GetNumAvatars()), Index);
+		Harness.TrackTask(Task);
+		Task->ReadyForActivation();
+	}
+	const double BurstSeconds = FPlatformTime::Seconds() - BurstStart;
+	const FAllocCounts BurstAllocsEnd = FAllocCounts::Capture();
+
+	const double FollowingFrameSeconds = Harness.TickWorld(FrameDeltaSeconds);
+	const FAllocCounts FollowingFrameAllocsEnd = FAllocCounts::Capture();
+	const FSnapshot After = FSnapshot::Capture();
+
+	// Leave the world as it was for the next scenario.
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (!ActorsBefore.Contains(*It))
+		{
+			It->Destroy();
+		}
+	}
+	Harness.EndAllTasks();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const FSnapshot AfterGC = FSnapshot::Capture();
+
+	const TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("task"), TaskName);
+	Result->SetStringField(TEXT("mode"), TEXT("burst"));
+	Result->SetNumberField(TEXT("count"), Count);
+	Result->SetNumberField(TEXT("burst_ns"), BurstSeconds * 1.0e9);
+	Result->SetNumberField(TEXT("ns_per_activation"), BurstSeconds * 1.0e9 / Count);
+	Result->SetNumberField(TEXT("following_frame_ns"), FollowingFrameSeconds * 1.0e9);
+	const double AllocsPerActivation = WriteAllocations(*Result, TEXT("activation"), BurstAllocsStart, BurstAllocsEnd, Count);
+	// The frame after the burst is where released tasks are recycled and spawned actors begin play.
+	WriteAllocations(*Result, TEXT("following_frame"), BurstAllocsEnd, FollowingFrameAllocsEnd, 1.0);
+	WriteDeltas(*Result, Before, After, AfterGC, Count);
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDBBenchmark: %-28s burst count=%-6d activation=%.1f ns  scene queries/activation=%.2f  allocs/activation=%.2f"),
+		TaskName, Count, BurstSeconds * 1.0e9 / Count, Result->GetNumberField(TEXT("scene_queries_per_activation")), AllocsPerActivation);
+	return Result;
+}
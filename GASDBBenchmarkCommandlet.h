@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASDBBenchmarkCommandlet.generated.h"
+
+class FGASDBTaskHarness;
+class FJsonObject;
+class UAbilityTask;
+class UGameplayAbility;
+
+/**
+ * Headless microbenchmark for the GASDB ability tasks.
+ *
+ *   UnrealEditor-Cmd <Project> -run=GASDBBenchmark -nullrhi -unattended [-Counts=1,100,1000,10000] [-Bursts=1,100,1000]
+ *       [-Frames=300] [-Warmup=30] [-Tasks=OnTickEvent,MoveRandomly,...] [-Output=<path>]
+ *
+ * Ticking tasks (OnTickEvent, MoveRandomly, MoveInDirection, RunTaskSequence) run concurrently on Count avatars for
+ * Frames frames; the cost of an idle frame with the same avatars is subtracted to give ns per task tick. Instant tasks
+ * (InstantMoveToLocation, SpawnSafeActor) are activated in bursts and report ns and scene queries per activation.
+ * Every scenario also reports allocations per activation and per task tick (FMalloc call counters, not available in
+ * Shipping) and the UObject count deltas before and after garbage collection.
+ * Results are written as JSON, by default to Saved/Profiling/GASDBBenchmark.json.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGASDBBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	using FTaskFactory = TFunction<UAbilityTask*(UGameplayAbility* OwningAbility, int32 Index)>;
+
+	TSharedRef<FJsonObject> RunTickScenario(FGASDBTaskHarness& Harness, const TCHAR* TaskName, const FTaskFactory& Factory, int32 Count, double IdleFrameSeconds);
+
+	TSharedRef<FJsonObject> RunBurstScenario(FGASDBTaskHarness& Harness, const TCHAR* TaskName, const FTaskFactory& Factory, int32 Count);
+
+	/** Average wall time of an idle frame with every avatar spawned and no tasks running */
+	double MeasureIdleFrame(FGASDBTaskHarness& Harness) const;
+
+	int32 NumFrames = 300;
+
+	int32 NumWarmupFrames = 30;
+};
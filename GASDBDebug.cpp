@@ -0,0 +1,43 @@
+#include "GASDBDebug.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogGASDB);
+
+namespace GASDBDebug
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("gasdb.Debug.Enable"),
+		bEnabled,
+		TEXT("Allow GASDB task debug drawing, on-screen messages and routine failure logging."),
+		ECVF_Default);
+
+	static bool bOnDedicatedServer = false;
+	static FAutoConsoleVariableRef CVarOnDedicatedServer(
+		TEXT("gasdb.Debug.OnDedicatedServer"),
+		bOnDedicatedServer,
+		TEXT("Also produce GASDB task debug output on dedicated servers, including PIE dedicated servers."),
+		ECVF_Default);
+
+	bool IsEnabled(const UObject* WorldContextObject)
+	{
+#if GASDB_STRIP_DEBUG
+		return false;
+#else
+		if (!bEnabled)
+		{
+			return false;
+		}
+
+		if (bOnDedicatedServer)
+		{
+			return true;
+		}
+
+		// A PIE dedicated server shares the editor process, so the process-wide check alone would miss it.
+		const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+		return World ? World->GetNetMode() != NM_DedicatedServer : !IsRunningDedicatedServer();
+#endif
+	}
+}
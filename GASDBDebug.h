@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject;
+
+/**
+ * Debug output of the GASDB tasks: on-screen messages, debug drawing and logging of routine failures (no player
+ * controller, spawn blocked, ...).
+ *
+ * GASDB_STRIP_DEBUG compiles all of it out. It defaults to on in dedicated server targets; set it from the module's
+ * Build.cs (PublicDefinitions.Add("GASDB_STRIP_DEBUG=1")) to load-test editor or client builds with server costs.
+ *
+ * Where it is compiled in, it still short-circuits at runtime on dedicated servers, PIE ones included, unless
+ * gasdb.Debug.OnDedicatedServer is set, and everywhere when gasdb.Debug.Enable is 0.
+ */
+#ifndef GASDB_STRIP_DEBUG
+#define GASDB_STRIP_DEBUG UE_SERVER
+#endif
+
+/** Log category of all GASDB code. Explicit command and commandlet output uses UE_LOG, everything routine GASDB_LOG. */
+LYRAGAME_API DECLARE_LOG_CATEGORY_EXTERN(LogGASDB, Log, All);
+
+namespace GASDBDebug
+{
+	/** Whether debug output should be produced for the world of WorldContextObject. Always false when stripped. */
+	LYRAGAME_API bool IsEnabled(const UObject* WorldContextObject);
+}
+
+/** UE_LOG to LogGASDB for routine task failures; the format arguments are not evaluated when debug output is off */
+#if GASDB_STRIP_DEBUG
+#define GASDB_LOG(WorldContextObject, Verbosity, Format, ...) do { } while (0)
+#else
+#define GASDB_LOG(WorldContextObject, Verbosity, Format, ...) \
+	do { if (GASDBDebug::IsEnabled(WorldContextObject)) { UE_LOG(LogGASDB, Verbosity, Format, ##__VA_ARGS__); } } while (0)
+#endif
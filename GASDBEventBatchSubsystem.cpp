@@ -0,0 +1,107 @@
+#include "GASDBEventBatchSubsystem.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "Engine/World.h"
+#include "GASDBTaskMetrics.h"
+#include "HAL/IConsoleManager.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBEventBatchSubsystem)
+
+namespace GASDBEventBatch
+{
+	static bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("gasdb.Events.BatchedDelivery"),
+		bEnabled,
+		TEXT("Deliver GASDB task events to the UGASDBEventBatchSubsystem dispatchers once per frame, as arrays, instead of one delegate broadcast per task."),
+		ECVF_Default);
+
+	template <typename TEntry, typename TDelegate>
+	static void Deliver(const TDelegate& Delegate, TArray<TEntry>& Pending, TArray<TEntry>& Delivering)
+	{
+		if (Pending.Num() == 0)
+		{
+			return;
+		}
+
+		// Both arrays keep their allocation, so a steady event rate stops allocating after the first frames.
+		Swap(Pending, Delivering);
+		Delegate.Broadcast(Delivering);
+		Delivering.Reset();
+	}
+}
+
+bool UGASDBEventBatchSubsystem::IsBatchedDeliveryEnabled()
+{
+	return GASDBEventBatch::bEnabled;
+}
+
+UGASDBEventBatchSubsystem* UGASDBEventBatchSubsystem::GetIfBatching(const UObject* WorldContextObject)
+{
+	if (!GASDBEventBatch::bEnabled)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASDBEventBatchSubsystem>() : nullptr;
+}
+
+bool UGASDBEventBatchSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UGASDBEventBatchSubsystem::QueueTickEvent(UAbilityTask* Task, const float DeltaTime)
+{
+	if (!OnTickEvents.IsBound())
+	{
+		return false;
+	}
+
+	PendingTickEvents.Add({ Task->GetInstanceName(), Task->Ability, DeltaTime });
+	return true;
+}
+
+bool UGASDBEventBatchSubsystem::QueueInputEvent(UAbilityTask* Task, const FInputActionValue& Value, const int32 LatencyCorrelationId)
+{
+	if (!OnInputEvents.IsBound())
+	{
+		return false;
+	}
+
+	PendingInputEvents.Add({ Task->GetInstanceName(), Task->Ability, Value, LatencyCorrelationId });
+	return true;
+}
+
+bool UGASDBEventBatchSubsystem::QueueMovementEnded(UAbilityTask* Task)
+{
+	if (!OnMovementEnded.IsBound())
+	{
+		return false;
+	}
+
+	PendingMovementEnded.Add({ Task->GetInstanceName(), Task->Ability });
+	return true;
+}
+
+void UGASDBEventBatchSubsystem::Tick(const float DeltaTime)
+{
+	GASDB_SCOPE(EventBatch_Deliver);
+
+	GASDBEventBatch::Deliver(OnTickEvents, PendingTickEvents, DeliveringTickEvents);
+	GASDBEventBatch::Deliver(OnInputEvents, PendingInputEvents, DeliveringInputEvents);
+	GASDBEventBatch::Deliver(OnMovementEnded, PendingMovementEnded, DeliveringMovementEnded);
+}
+
+TStatId UGASDBEventBatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASDBEventBatchSubsystem, STATGROUP_Tickables);
+}
+
+void UGASDBEventBatchSubsystem::Deinitialize()
+{
+	PendingTickEvents.Reset();
+	PendingInputEvents.Reset();
+	PendingMovementEnded.Reset();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASDBEventBatchSubsystem.generated.h"
+
+class UAbilityTask;
+class UGameplayAbility;
+
+/** One TickEventReceived from an OnTickEvent task */
+USTRUCT(BlueprintType)
+struct FGASDBTickEventEntry
+{
+	GENERATED_BODY()
+
+	/**
+	 * Instance name of the task that raised the event; together with Ability it identifies the task. The task object is
+	 * not handed out because with task pooling on it may already serve another activation by delivery.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	FName InstanceName;
+
+	/** The ability that owned the task when the event was raised */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	TObjectPtr<UGameplayAbility> Ability = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	float DeltaTime = 0.f;
+};
+
+/** One InputEventReceived from a WaitEnhancedInputEvent task */
+USTRUCT(BlueprintType)
+struct FGASDBInputEventEntry
+{
+	GENERATED_BODY()
+
+	/**
+	 * Instance name of the task that raised the event; together with Ability it identifies the task. The task object is
+	 * not handed out because with task pooling on it may already serve another activation by delivery.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	FName InstanceName;
+
+	/** The ability that owned the task when the event was raised */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	TObjectPtr<UGameplayAbility> Ability = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	FInputActionValue Value;
+
+	/** Latency trace the input belongs to (gasdb.Latency.Enable), 0 when tracing is off */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	int32 LatencyCorrelationId = 0;
+};
+
+/** One movement task reaching its end (OnMoveRandomlyEnd) */
+USTRUCT(BlueprintType)
+struct FGASDBMovementEndedEntry
+{
+	GENERATED_BODY()
+
+	/**
+	 * Instance name of the task that raised the event; together with Ability it identifies the task. The task object is
+	 * not handed out because with task pooling on it may already serve another activation by delivery.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	FName InstanceName;
+
+	/** The ability that owned the task when the event was raised */
+	UPROPERTY(BlueprintReadOnly, Category = "GASDB|Events")
+	TObjectPtr<UGameplayAbility> Ability = nullptr;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGASDBTickEventBatchDelegate, const TArray<FGASDBTickEventEntry>&, Events);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGASDBInputEventBatchDelegate, const TArray<FGASDBInputEventEntry>&, Events);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGASDBMovementEndedBatchDelegate, const TArray<FGASDBMovementEndedEntry>&, Events);
+
+/**
+ * Collects same-type events from every GASDB task instance in the world and delivers them once per frame as an
+ * array, so Blueprint handles hundreds of instances in one VM call instead of one ProcessEvent per instance.
+ *
+ * Opt-in twice: gasdb.Events.BatchedDelivery turns the subsystem on, and only tasks created through a batched factory
+ * (OnTickEventBatched, WaitEnhancedInputEventBatched, MoveRandomlyBatched) take part. While both hold and a batch
+ * dispatcher has a listener, such a task queues that type of event here instead of broadcasting its own delegate;
+ * otherwise it broadcasts as before. Tasks from the regular factories always broadcast their own delegate. Batches go
+ * out after the world's tick groups and timers have run, ticks first, then input, then movement ends, so an event
+ * reaches Blueprint later in the same frame rather than at the point it was raised.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBEventBatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsBatchedDeliveryEnabled();
+
+	/** The world's subsystem if batched delivery is on, so the off path costs one bool test */
+	static UGASDBEventBatchSubsystem* GetIfBatching(const UObject* WorldContextObject);
+
+	/** Queues the event for this frame's batch. Returns false if nothing listens for the batch; broadcast it directly then. */
+	bool QueueTickEvent(UAbilityTask* Task, float DeltaTime);
+	bool QueueInputEvent(UAbilityTask* Task, const FInputActionValue& Value, int32 LatencyCorrelationId = 0);
+	bool QueueMovementEnded(UAbilityTask* Task);
+
+	/** Every TickEventReceived of the frame from OnTickEventBatched tasks */
+	UPROPERTY(BlueprintAssignable, Category = "GASDB|Events")
+	FGASDBTickEventBatchDelegate OnTickEvents;
+
+	/** Every InputEventReceived of the frame from WaitEnhancedInputEventBatched tasks */
+	UPROPERTY(BlueprintAssignable, Category = "GASDB|Events")
+	FGASDBInputEventBatchDelegate OnInputEvents;
+
+	/** Every OnMoveRandomlyEnd of the frame from MoveRandomlyBatched tasks */
+	UPROPERTY(BlueprintAssignable, Category = "GASDB|Events")
+	FGASDBMovementEndedBatchDelegate OnMovementEnded;
+
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End UTickableWorldSubsystem Interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Events raised this frame. Listeners get the Delivering copy so anything they raise lands in the next batch. */
+	UPROPERTY(Transient)
+	TArray<FGASDBTickEventEntry> PendingTickEvents;
+
+	UPROPERTY(Transient)
+	TArray<FGASDBInputEventEntry> PendingInputEvents;
+
+	UPROPERTY(Transient)
+	TArray<FGASDBMovementEndedEntry> PendingMovementEnded;
+
+	UPROPERTY(Transient)
+	TArray<FGASDBTickEventEntry> DeliveringTickEvents;
+
+	UPROPERTY(Transient)
+	TArray<FGASDBInputEventEntry> DeliveringInputEvents;
+
+	UPROPERTY(Transient)
+	TArray<FGASDBMovementEndedEntry> DeliveringMovementEnded;
+};
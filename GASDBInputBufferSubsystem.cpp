@@ -0,0 +1,251 @@
+#include "GASDBInputBufferSubsystem.h"
+#include "EnhancedInputComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBInputBufferSubsystem)
+
+void FGASDBInputEventRing::Push(const UInputAction* InputAction, const ETriggerEvent TriggerEvent, const FInputActionValue& Value, const double Timestamp)
+{
+	int32 SlotIndex;
+	if (Count < Capacity)
+	{
+		SlotIndex = (Head + Count) & (Capacity - 1);
+		++Count;
+	}
+	else
+	{
+		// Full: overwrite the oldest event and advance the head.
+		SlotIndex = Head;
+		Head = (Head + 1) & (Capacity - 1);
+	}
+
+	FGASDBBufferedInputEvent& Slot = Events[SlotIndex];
+	Slot.InputAction = InputAction;
+	Slot.TriggerEvent = TriggerEvent;
+	Slot.Value = Value;
+	Slot.Timestamp = Timestamp;
+	Slot.Sequence = NextSequence++;
+	Slot.bConsumed = false;
+}
+
+UGASDBInputBufferSubsystem* UGASDBInputBufferSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASDBInputBufferSubsystem>() : nullptr;
+}
+
+bool UGASDBInputBufferSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UGASDBInputBufferSubsystem::FControllerBuffer* UGASDBInputBufferSubsystem::FindOrAddBuffer(const APlayerController* PlayerController)
+{
+	if (!PlayerController)
+	{
+		return nullptr;
+	}
+
+	UEnhancedInputComponent* InputComponent = Cast<UEnhancedInputComponent>(PlayerController->InputComponent);
+	if (!InputComponent)
+	{
+		return nullptr;
+	}
+
+	FControllerBuffer& Buffer = Buffers.FindOrAdd(PlayerController);
+	if (Buffer.InputComponent.Get() != InputComponent)
+	{
+		// The controller rebuilt its input component (or this is a new entry); previous bindings are gone with it.
+		Buffer.InputComponent = InputComponent;
+		Buffer.RecordedActions.Reset();
+		Buffer.BindingHandles.Reset();
+	}
+	return &Buffer;
+}
+
+bool UGASDBInputBufferSubsystem::EnsureRecording(const APlayerController* PlayerController, const UInputAction* InputAction, const ETriggerEvent TriggerEvent)
+{
+	if (!InputAction)
+	{
+		return false;
+	}
+
+	FControllerBuffer* Buffer = FindOrAddBuffer(PlayerController);
+	if (!Buffer)
+	{
+		return false;
+	}
+
+	bool bAlreadyRecording = false;
+	Buffer->RecordedActions.Add(MakeTuple(TObjectKey<UInputAction>(InputAction), TriggerEvent), &bAlreadyRecording);
+	if (!bAlreadyRecording)
+	{
+		const FEnhancedInputActionEventBinding& Binding = Buffer->InputComponent->BindAction(InputAction, TriggerEvent, this, &UGASDBInputBufferSubsystem::RecordEvent, TObjectKey<APlayerController>(PlayerController));
+		Buffer->BindingHandles.Add(Binding.GetHandle());
+	}
+	return true;
+}
+
+void UGASDBInputBufferSubsystem::RecordEvent(const FInputActionInstance& Instance, const TObjectKey<APlayerController> ControllerKey)
+{
+	if (FControllerBuffer* Buffer = Buffers.Find(ControllerKey))
+	{
+		Buffer->Ring.Push(Instance.GetSourceAction(), Instance.GetTriggerEvent(), Instance.GetValue(), FPlatformTime::Seconds());
+	}
+}
+
+bool UGASDBInputBufferSubsystem::RegisterBufferedAction(const APlayerController* PlayerController, const UInputAction* InputAction, const ETriggerEvent TriggerEvent)
+{
+	// Remote controllers on the server have no input to record.
+	return PlayerController && PlayerController->IsLocalController() && EnsureRecording(PlayerController, InputAction, TriggerEvent);
+}
+
+int32 UGASDBInputBufferSubsystem::ConsumeEvents(const APlayerController* PlayerController, const UInputAction* InputAction, const ETriggerEvent TriggerEvent, const double LookbackSeconds, TArray<FGASDBBufferedInputEvent>& OutEvents, const bool bMarkConsumed, const int32 MaxEvents)
+{
+	FControllerBuffer* Buffer = Buffers.Find(PlayerController);
+	if (!Buffer || !InputAction)
+	{
+		return 0;
+	}
+
+	const double OldestAllowed = FPlatformTime::Seconds() - LookbackSeconds;
+	const int32 StartNum = OutEvents.Num();
+
+	for (int32 Index = 0; Index < Buffer->Ring.Num() && OutEvents.Num() - StartNum < MaxEvents; ++Index)
+	{
+		FGASDBBufferedInputEvent& Event = Buffer->Ring.GetFromOldest(Index);
+		if (Event.bConsumed || Event.Timestamp < OldestAllowed || Event.TriggerEvent != TriggerEvent || Event.InputAction.Get() != InputAction)
+		{
+			continue;
+		}
+
+		OutEvents.Add(Event);
+		Event.bConsumed |= bMarkConsumed;
+	}
+
+	return OutEvents.Num() - StartNum;
+}
+
+FDelegateHandle UGASDBInputBufferSubsystem::RegisterListener(const APlayerController* PlayerController, const UInputAction* InputAction, const ETriggerEvent TriggerEvent, FGASDBOnBufferedInputBatch&& Delegate)
+{
+	if (!EnsureRecording(PlayerController, InputAction, TriggerEvent))
+	{
+		return FDelegateHandle();
+	}
+
+	FControllerBuffer& Buffer = Buffers.FindChecked(PlayerController);
+	FListener& Listener = Buffer.Listeners.AddDefaulted_GetRef();
+	Listener.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Listener.InputAction = InputAction;
+	Listener.TriggerEvent = TriggerEvent;
+	Listener.Delegate = MoveTemp(Delegate);
+	return Listener.Handle;
+}
+
+void UGASDBInputBufferSubsystem::UnregisterListener(const APlayerController* PlayerController, const FDelegateHandle Handle)
+{
+	if (FControllerBuffer* Buffer = Buffers.Find(PlayerController))
+	{
+		Buffer->Listeners.RemoveAllSwap([Handle](const FListener& Listener) { return Listener.Handle == Handle; });
+	}
+}
+
+void UGASDBInputBufferSubsystem::DrainBuffer(FControllerBuffer& Buffer)
+{
+	const uint64 LatestSequence = Buffer.Ring.GetLatestSequence();
+	if (LatestSequence == Buffer.LastDrainedSequence)
+	{
+		return;
+	}
+
+	const uint64 FirstNewSequence = Buffer.LastDrainedSequence + 1;
+	Buffer.LastDrainedSequence = LatestSequence;
+
+	if (Buffer.Listeners.Num() == 0)
+	{
+		return;
+	}
+
+	// Listeners may unregister (e.g. a trigger-once task ending) while we deliver, so work on a snapshot.
+	TArray<FListener, TInlineAllocator<8>> Listeners(Buffer.Listeners);
+	TArray<FGASDBBufferedInputEvent, TInlineAllocator<16>> Batch;
+	TArray<FGASDBBufferedInputEvent*, TInlineAllocator<16>> BatchSlots;
+	TArray<FGASDBBufferedInputEvent*, TInlineAllocator<16>> Handled;
+
+	for (const FListener& Listener : Listeners)
+	{
+		// Skip listeners removed by an earlier delivery; a pooled task may already be bound again under a new handle.
+		const FDelegateHandle Handle = Listener.Handle;
+		if (!Buffer.Listeners.ContainsByPredicate([Handle](const FListener& Registered) { return Registered.Handle == Handle; }))
+		{
+			continue;
+		}
+
+		Batch.Reset();
+		BatchSlots.Reset();
+		for (int32 Index = 0; Index < Buffer.Ring.Num(); ++Index)
+		{
+			FGASDBBufferedInputEvent& Event = Buffer.Ring.GetFromOldest(Index);
+			if (Event.Sequence < FirstNewSequence || Event.bConsumed
+				|| Event.TriggerEvent != Listener.TriggerEvent || Event.InputAction != Listener.InputAction)
+			{
+				continue;
+			}
+
+			Batch.Add(Event);
+			BatchSlots.Add(&Event);
+		}
+
+		if (Batch.Num() > 0 && Listener.Delegate.IsBound())
+		{
+			const int32 NumHandled = FMath::Clamp(Listener.Delegate.Execute(Batch), 0, Batch.Num());
+			for (int32 Index = 0; Index < NumHandled; ++Index)
+			{
+				Handled.AddUnique(BatchSlots[Index]);
+			}
+		}
+	}
+
+	// Events a live listener handled are not available for later lookback; the rest stay for later tasks.
+	for (FGASDBBufferedInputEvent* Event : Handled)
+	{
+		Event->bConsumed = true;
+	}
+}
+
+void UGASDBInputBufferSubsystem::Tick(const float DeltaTime)
+{
+	for (auto It = Buffers.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr() || !It.Value().InputComponent.IsValid())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		DrainBuffer(It.Value());
+	}
+}
+
+TStatId UGASDBInputBufferSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASDBInputBufferSubsystem, STATGROUP_Tickables);
+}
+
+void UGASDBInputBufferSubsystem::Deinitialize()
+{
+	for (TPair<TObjectKey<APlayerController>, FControllerBuffer>& Pair : Buffers)
+	{
+		if (UEnhancedInputComponent* InputComponent = Pair.Value.InputComponent.Get())
+		{
+			for (const uint32 BindingHandle : Pair.Value.BindingHandles)
+			{
+				InputComponent->RemoveBindingByHandle(BindingHandle);
+			}
+		}
+	}
+	Buffers.Reset();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+#include "InputTriggers.h"
+#include "Containers/StaticArray.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GASDBInputBufferSubsystem.generated.h"
+
+class APlayerController;
+class UEnhancedInputComponent;
+class UInputAction;
+struct FInputActionInstance;
+
+/** A single input action event captured by the input buffer. */
+struct FGASDBBufferedInputEvent
+{
+	/** The action that produced this event */
+	TWeakObjectPtr<const UInputAction> InputAction;
+
+	/** The trigger event this value was reported for */
+	ETriggerEvent TriggerEvent = ETriggerEvent::None;
+
+	/** The action value at the time of the event */
+	FInputActionValue Value;
+
+	/** High resolution timestamp (FPlatformTime::Seconds) at which the event was received */
+	double Timestamp = 0.0;
+
+	/** Monotonic sequence number, unique per controller. Zero means "never written". */
+	uint64 Sequence = 0;
+
+	/** Set once a task has taken this event, so it is not handed out twice */
+	bool bConsumed = false;
+};
+
+/** Fixed-size ring of the most recent input events of one controller. The oldest entry is overwritten when full. */
+struct FGASDBInputEventRing
+{
+	static constexpr int32 Capacity = 64;
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	void Push(const UInputAction* InputAction, ETriggerEvent TriggerEvent, const FInputActionValue& Value, double Timestamp);
+
+	int32 Num() const { return Count; }
+
+	/** Access an event by age, 0 being the oldest event still held */
+	FGASDBBufferedInputEvent& GetFromOldest(int32 Index) { return Events[(Head + Index) & (Capacity - 1)]; }
+	const FGASDBBufferedInputEvent& GetFromOldest(int32 Index) const { return Events[(Head + Index) & (Capacity - 1)]; }
+
+	/** Sequence number of the newest event, or zero when empty */
+	uint64 GetLatestSequence() const { return NextSequence - 1; }
+
+private:
+	TStaticArray<FGASDBBufferedInputEvent, Capacity> Events;
+	int32 Head = 0;
+	int32 Count = 0;
+	uint64 NextSequence = 1;
+};
+
+/**
+ * Receives every new buffered event matching a listener's action and trigger, once per frame.
+ * Returns how many events, from the front of the batch, the listener handled; only those are marked consumed.
+ */
+DECLARE_DELEGATE_RetVal_OneParam(int32, FGASDBOnBufferedInputBatch, TConstArrayView<FGASDBBufferedInputEvent>);
+
+/**
+ * Keeps a per-PlayerController ring buffer of recent Enhanced Input action events with timestamps.
+ *
+ * Tasks can look back into the buffer at activation to pick up presses that landed before they were
+ * bound, and listeners receive new events in one batch per frame instead of one delegate call per event.
+ *
+ * Events are only recorded for an (action, trigger) once something asked for it. Without RegisterBufferedAction the
+ * first buffered task for an action starts the recording itself and so finds an empty lookback; register the actions
+ * an ability waits on when the controller possesses its pawn or when the ability is given.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBInputBufferSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGASDBInputBufferSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Makes sure events for the given action and trigger are being recorded for the controller.
+	 * Binding is done once per (controller, action, trigger); later calls are no-ops.
+	 * @return	False if the controller has no Enhanced Input Component.
+	 */
+	bool EnsureRecording(const APlayerController* PlayerController, const UInputAction* InputAction, ETriggerEvent TriggerEvent);
+
+	/**
+	 * Starts buffering an action ahead of the tasks that will wait on it, so their lookback already holds presses made
+	 * before the first of them activated. Only records on the locally controlled PlayerController; call it again after
+	 * the controller recreates its input component.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GASDB|Input")
+	bool RegisterBufferedAction(const APlayerController* PlayerController, const UInputAction* InputAction, ETriggerEvent TriggerEvent);
+
+	/**
+	 * Copies unconsumed events for the action and trigger that are at most LookbackSeconds old into OutEvents, oldest first.
+	 * @param bMarkConsumed	If true, the returned events are not handed out again by later calls or batches.
+	 * @param MaxEvents		At most this many events are returned, and marked consumed; e.g. 1 for a trigger-once task.
+	 * @return				Number of events appended to OutEvents.
+	 */
+	int32 ConsumeEvents(const APlayerController* PlayerController, const UInputAction* InputAction, ETriggerEvent TriggerEvent, double LookbackSeconds, TArray<FGASDBBufferedInputEvent>& OutEvents, bool bMarkConsumed = true, int32 MaxEvents = MAX_int32);
+
+	/** Registers a listener that receives new matching events once per frame. Starts recording if needed. */
+	FDelegateHandle RegisterListener(const APlayerController* PlayerController, const UInputAction* InputAction, ETriggerEvent TriggerEvent, FGASDBOnBufferedInputBatch&& Delegate);
+
+	/** Removes a listener previously added by RegisterListener. */
+	void UnregisterListener(const APlayerController* PlayerController, FDelegateHandle Handle);
+
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End UTickableWorldSubsystem Interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FListener
+	{
+		FDelegateHandle Handle;
+		TWeakObjectPtr<const UInputAction> InputAction;
+		ETriggerEvent TriggerEvent = ETriggerEvent::None;
+		FGASDBOnBufferedInputBatch Delegate;
+	};
+
+	struct FControllerBuffer
+	{
+		FGASDBInputEventRing Ring;
+		TWeakObjectPtr<UEnhancedInputComponent> InputComponent;
+		TSet<TPair<TObjectKey<UInputAction>, ETriggerEvent>> RecordedActions;
+		TArray<uint32> BindingHandles;
+		TArray<FListener> Listeners;
+		uint64 LastDrainedSequence = 0;
+	};
+
+	/** Bound to the Enhanced Input Component; appends the event to the controller's ring */
+	void RecordEvent(const FInputActionInstance& Instance, TObjectKey<APlayerController> ControllerKey);
+
+	/** Hands every event recorded since the last drain to the matching listeners */
+	void DrainBuffer(FControllerBuffer& Buffer);
+
+	FControllerBuffer* FindOrAddBuffer(const APlayerController* PlayerController);
+
+	TMap<TObjectKey<APlayerController>, FControllerBuffer> Buffers;
+};
@@ -0,0 +1,305 @@
+#include "GASDBInputForwardingComponent.h"
+#include "GameFramework/Controller.h"
+#include "HAL/PlatformTime.h"
+#include "InputAction.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBInputForwardingComponent)
+
+namespace GASDBInputForwarding
+{
+	static int16 QuantizeComponent(const double Component)
+	{
+		const double Scaled = FMath::RoundToDouble(Component * FGASDBQuantizedInputValue::QuantizeScale);
+		return static_cast<int16>(FMath::Clamp(Scaled, static_cast<double>(MIN_int16), static_cast<double>(MAX_int16)));
+	}
+
+	/** True if sequence A was sent after sequence B, allowing for wrap-around */
+	static bool IsNewerSequence(const uint16 A, const uint16 B)
+	{
+		return static_cast<int16>(A - B) > 0;
+	}
+}
+
+FGASDBQuantizedInputValue FGASDBQuantizedInputValue::Quantize(const FInputActionValue& Value)
+{
+	const FVector Axis = Value.Get<FVector>();
+
+	FGASDBQuantizedInputValue Result;
+	Result.ValueType = static_cast<uint8>(Value.GetValueType());
+	Result.X = GASDBInputForwarding::QuantizeComponent(Axis.X);
+	Result.Y = GASDBInputForwarding::QuantizeComponent(Axis.Y);
+	Result.Z = GASDBInputForwarding::QuantizeComponent(Axis.Z);
+	return Result;
+}
+
+FInputActionValue FGASDBQuantizedInputValue::Dequantize() const
+{
+	const FVector Axis(X / QuantizeScale, Y / QuantizeScale, Z / QuantizeScale);
+	return FInputActionValue(static_cast<EInputActionValueType>(ValueType), Axis);
+}
+
+bool FGASDBQuantizedInputValue::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Two bits of value type, then only the components that type uses. Booleans take a single bit.
+	uint32 PackedType = ValueType;
+	Ar.SerializeBits(&PackedType, 2);
+
+	if (Ar.IsLoading())
+	{
+		ValueType = static_cast<uint8>(PackedType);
+		X = Y = Z = 0;
+	}
+
+	switch (static_cast<EInputActionValueType>(ValueType))
+	{
+	case EInputActionValueType::Boolean:
+	{
+		uint8 bPressed = X != 0 ? 1 : 0;
+		Ar.SerializeBits(&bPressed, 1);
+		X = bPressed ? static_cast<int16>(QuantizeScale) : 0;
+		break;
+	}
+	case EInputActionValueType::Axis3D:
+		Ar << Z;
+		[[fallthrough]];
+	case EInputActionValueType::Axis2D:
+		Ar << Y;
+		[[fallthrough]];
+	case EInputActionValueType::Axis1D:
+		Ar << X;
+		break;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+UGASDBInputForwardingComponent::UGASDBInputForwardingComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	SetIsReplicatedByDefault(true);
+}
+
+UGASDBInputForwardingComponent* UGASDBInputForwardingComponent::FindForController(const AController* Controller)
+{
+	return Controller ? Controller->FindComponentByClass<UGASDBInputForwardingComponent>() : nullptr;
+}
+
+UGASDBInputForwardingComponent::FPendingBatch* UGASDBInputForwardingComponent::FindPendingBatch(const FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, const ETriggerEvent TriggerEvent)
+{
+	return PendingBatches.FindByPredicate([&](const FPendingBatch& Pending)
+	{
+		return Pending.Batch.AbilityHandle == AbilityHandle && Pending.Batch.InputAction == InputAction && Pending.Batch.TriggerEvent == TriggerEvent;
+	});
+}
+
+void UGASDBInputForwardingComponent::QueueInput(const FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, const ETriggerEvent TriggerEvent, const FInputActionValue& Value, const float FlushInterval)
+{
+	FPendingBatch* Pending = FindPendingBatch(AbilityHandle, InputAction, TriggerEvent);
+	if (!Pending)
+	{
+		Pending = &PendingBatches.AddDefaulted_GetRef();
+		Pending->Batch.AbilityHandle = AbilityHandle;
+		Pending->Batch.InputAction = InputAction;
+		Pending->Batch.TriggerEvent = TriggerEvent;
+		Pending->FirstQueuedTime = FPlatformTime::Seconds();
+		Pending->FlushInterval = FMath::Max(FlushInterval, 0.f);
+	}
+
+	// Held or continuous triggers mostly repeat the same value; only changes are worth sending.
+	const FGASDBQuantizedInputValue Quantized = FGASDBQuantizedInputValue::Quantize(Value);
+	TArray<FGASDBQuantizedInputValue>& Values = Pending->Batch.Values;
+	if (Values.Num() > 0 && Values.Last() == Quantized)
+	{
+		return;
+	}
+
+	if (Values.Num() >= MaxValuesPerBatch)
+	{
+		Values.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+	Values.Add(Quantized);
+
+	SetComponentTickEnabled(true);
+}
+
+void UGASDBInputForwardingComponent::FlushPendingBatch(const int32 PendingIndex)
+{
+	FGASDBInputBatch& Batch = PendingBatches[PendingIndex].Batch;
+	if (Batch.Values.Num() > 0)
+	{
+		Batch.Sequence = ++NextSequence;
+		ServerReceiveInputBatch(Batch);
+	}
+	PendingBatches.RemoveAtSwap(PendingIndex, 1, EAllowShrinking::No);
+}
+
+void UGASDBInputForwardingComponent::SendFinalState(const FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, const ETriggerEvent TriggerEvent, const FInputActionValue& Value)
+{
+	if (FPendingBatch* Pending = FindPendingBatch(AbilityHandle, InputAction, TriggerEvent))
+	{
+		FlushPendingBatch(static_cast<int32>(Pending - PendingBatches.GetData()));
+	}
+
+	FGASDBInputBatch FinalState;
+	FinalState.AbilityHandle = AbilityHandle;
+	FinalState.InputAction = InputAction;
+	FinalState.TriggerEvent = TriggerEvent;
+	FinalState.Sequence = ++NextSequence;
+	FinalState.Values.Add(FGASDBQuantizedInputValue::Quantize(Value));
+	ServerReceiveFinalInputState(FinalState);
+}
+
+void UGASDBInputForwardingComponent::TickComponent(const float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = PendingBatches.Num() - 1; Index >= 0; --Index)
+	{
+		const FPendingBatch& Pending = PendingBatches[Index];
+		if (Now - Pending.FirstQueuedTime >= Pending.FlushInterval)
+		{
+			FlushPendingBatch(Index);
+		}
+	}
+
+	if (UnclaimedBatches.Num() > 0)
+	{
+		DispatchUnclaimedBatches();
+	}
+
+	if (PendingBatches.Num() == 0 && UnclaimedBatches.Num() == 0)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+FDelegateHandle UGASDBInputForwardingComponent::RegisterReceiver(const FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, const ETriggerEvent TriggerEvent, FGASDBOnForwardedInput&& Delegate)
+{
+	FReceiver& Receiver = Receivers.AddDefaulted_GetRef();
+	Receiver.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Receiver.AbilityHandle = AbilityHandle;
+	Receiver.InputAction = InputAction;
+	Receiver.TriggerEvent = TriggerEvent;
+	Receiver.Delegate = MoveTemp(Delegate);
+
+	// Delivered from the tick rather than here, so the caller holds the handle before its delegate can run.
+	if (UnclaimedBatches.Num() > 0)
+	{
+		SetComponentTickEnabled(true);
+	}
+
+	return Receiver.Handle;
+}
+
+void UGASDBInputForwardingComponent::UnregisterReceiver(const FDelegateHandle Handle)
+{
+	Receivers.RemoveAllSwap([Handle](const FReceiver& Receiver) { return Receiver.Handle == Handle; });
+}
+
+bool UGASDBInputForwardingComponent::DispatchBatch(const FGASDBInputBatch& Batch, const bool bIsFinalState)
+{
+	if (Batch.Values.Num() == 0 || Batch.Values.Num() > MaxValuesPerBatch)
+	{
+		// Malformed; claimed so it is not kept around either.
+		return true;
+	}
+
+	TArray<FInputActionValue, TInlineAllocator<16>> Values;
+	Values.Reserve(Batch.Values.Num());
+	for (const FGASDBQuantizedInputValue& Quantized : Batch.Values)
+	{
+		Values.Add(Quantized.Dequantize());
+	}
+
+	// Receivers can unregister from inside the callback (e.g. a task ending on its final state), so gather first.
+	TArray<FGASDBOnForwardedInput, TInlineAllocator<4>> Delegates;
+	bool bHasReceiver = false;
+	for (FReceiver& Receiver : Receivers)
+	{
+		if (Receiver.AbilityHandle != Batch.AbilityHandle || Receiver.TriggerEvent != Batch.TriggerEvent || Receiver.InputAction.Get() != Batch.InputAction)
+		{
+			continue;
+		}
+
+		bHasReceiver = true;
+
+		// Unreliable batches can arrive late or after the reliable final state; never step backwards.
+		if (Receiver.bFinalStateReceived || (Receiver.bHasReceived && !GASDBInputForwarding::IsNewerSequence(Batch.Sequence, Receiver.LastSequence)))
+		{
+			continue;
+		}
+
+		Receiver.bHasReceived = true;
+		Receiver.LastSequence = Batch.Sequence;
+		Receiver.bFinalStateReceived = bIsFinalState;
+		Delegates.Add(Receiver.Delegate);
+	}
+
+	for (const FGASDBOnForwardedInput& Delegate : Delegates)
+	{
+		Delegate.ExecuteIfBound(Values, bIsFinalState);
+	}
+
+	return bHasReceiver;
+}
+
+void UGASDBInputForwardingComponent::AddUnclaimedBatch(const FGASDBInputBatch& Batch, const bool bIsFinalState)
+{
+	if (UnclaimedBatchLifetime <= 0.f)
+	{
+		return;
+	}
+
+	if (UnclaimedBatches.Num() >= MaxUnclaimedBatches)
+	{
+		UnclaimedBatches.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	FUnclaimedBatch& Unclaimed = UnclaimedBatches.AddDefaulted_GetRef();
+	Unclaimed.Batch = Batch;
+	Unclaimed.bIsFinalState = bIsFinalState;
+	Unclaimed.ReceivedTime = FPlatformTime::Seconds();
+
+	// Expires them even if no receiver ever registers.
+	SetComponentTickEnabled(true);
+}
+
+void UGASDBInputForwardingComponent::DispatchUnclaimedBatches()
+{
+	// Taken out first: a receiver may end its task, and batches that still find nobody go back in arrival order.
+	TArray<FUnclaimedBatch> Unclaimed = MoveTemp(UnclaimedBatches);
+	UnclaimedBatches.Reset();
+
+	const double OldestAllowed = FPlatformTime::Seconds() - UnclaimedBatchLifetime;
+	for (FUnclaimedBatch& Entry : Unclaimed)
+	{
+		if (Entry.ReceivedTime < OldestAllowed)
+		{
+			continue;
+		}
+
+		if (!DispatchBatch(Entry.Batch, Entry.bIsFinalState))
+		{
+			UnclaimedBatches.Add(MoveTemp(Entry));
+		}
+	}
+}
+
+void UGASDBInputForwardingComponent::ServerReceiveInputBatch_Implementation(const FGASDBInputBatch& Batch)
+{
+	if (!DispatchBatch(Batch, false))
+	{
+		AddUnclaimedBatch(Batch, false);
+	}
+}
+
+void UGASDBInputForwardingComponent::ServerReceiveFinalInputState_Implementation(const FGASDBInputBatch& Batch)
+{
+	if (!DispatchBatch(Batch, true))
+	{
+		AddUnclaimedBatch(Batch, true);
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "InputActionValue.h"
+#include "InputTriggers.h"
+#include "GASDBInputForwardingComponent.generated.h"
+
+class AController;
+class UInputAction;
+
+/**
+ * An FInputActionValue packed for the wire.
+ * Components are stored as 16 bit fixed point with 1/1024 precision, which covers [-32, 32]; larger values are clamped.
+ */
+USTRUCT()
+struct FGASDBQuantizedInputValue
+{
+	GENERATED_BODY()
+
+	static constexpr float QuantizeScale = 1024.f;
+
+	static FGASDBQuantizedInputValue Quantize(const FInputActionValue& Value);
+	FInputActionValue Dequantize() const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FGASDBQuantizedInputValue& Other) const
+	{
+		return ValueType == Other.ValueType && X == Other.X && Y == Other.Y && Z == Other.Z;
+	}
+
+	bool operator!=(const FGASDBQuantizedInputValue& Other) const { return !(*this == Other); }
+
+	/** EInputActionValueType; decides how many components go on the wire */
+	uint8 ValueType = 0;
+	int16 X = 0;
+	int16 Y = 0;
+	int16 Z = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGASDBQuantizedInputValue> : public TStructOpsTypeTraitsBase2<FGASDBQuantizedInputValue>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/** All values one ability produced for one input action and trigger during a forwarding window. */
+USTRUCT()
+struct FGASDBInputBatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayAbilitySpecHandle AbilityHandle;
+
+	UPROPERTY()
+	TObjectPtr<const UInputAction> InputAction = nullptr;
+
+	UPROPERTY()
+	ETriggerEvent TriggerEvent = ETriggerEvent::None;
+
+	/** Increases with every batch sent for the same key; lets the server drop late unreliable batches */
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	/** Values in the order they were received, consecutive duplicates removed */
+	UPROPERTY()
+	TArray<FGASDBQuantizedInputValue> Values;
+};
+
+/** Server side receiver for forwarded input. bIsFinalState is set for the reliable state sent when the client task ends. */
+DECLARE_DELEGATE_TwoParams(FGASDBOnForwardedInput, TConstArrayView<FInputActionValue> /*Values*/, bool /*bIsFinalState*/);
+
+/**
+ * Forwards input received by WaitEnhancedInputEvent on an owning client to the server.
+ *
+ * Values are coalesced per (ability, action, trigger) over a frame or a configurable window and sent as one
+ * unreliable batch; when the client task ends the last value is sent reliably so the server always sees the final state.
+ * Add this component to your PlayerController class to enable server forwarding.
+ */
+UCLASS(ClassGroup = (Abilities), meta = (BlueprintSpawnableComponent))
+class LYRAGAME_API UGASDBInputForwardingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGASDBInputForwardingComponent(const FObjectInitializer& ObjectInitializer);
+
+	/** Finds the forwarding component on the controller, if the project added one. */
+	static UGASDBInputForwardingComponent* FindForController(const AController* Controller);
+
+	/** Client: queues a value to be sent with the next batch for this key. A FlushInterval of 0 sends once per frame. */
+	void QueueInput(FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, ETriggerEvent TriggerEvent, const FInputActionValue& Value, float FlushInterval);
+
+	/** Client: flushes anything pending for this key and reliably sends the final value. */
+	void SendFinalState(FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, ETriggerEvent TriggerEvent, const FInputActionValue& Value);
+
+	/** Server: receives forwarded values for the given key until unregistered. Batches that arrived first are delivered on the next tick. */
+	FDelegateHandle RegisterReceiver(FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, ETriggerEvent TriggerEvent, FGASDBOnForwardedInput&& Delegate);
+
+	/** Server: removes a receiver previously added by RegisterReceiver. */
+	void UnregisterReceiver(FDelegateHandle Handle);
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Upper bound on values per batch; when exceeded the oldest values are dropped in favour of the latest */
+	UPROPERTY(EditDefaultsOnly, Category = "Input Forwarding", meta = (ClampMin = "1", ClampMax = "255"))
+	int32 MaxValuesPerBatch = 16;
+
+	/** Server: how long batches that arrive before the server task registered are kept for it, in seconds */
+	UPROPERTY(EditDefaultsOnly, Category = "Input Forwarding", meta = (ClampMin = "0"))
+	float UnclaimedBatchLifetime = 1.f;
+
+protected:
+	UFUNCTION(Server, Unreliable)
+	void ServerReceiveInputBatch(const FGASDBInputBatch& Batch);
+
+	UFUNCTION(Server, Reliable)
+	void ServerReceiveFinalInputState(const FGASDBInputBatch& Batch);
+
+private:
+	struct FPendingBatch
+	{
+		FGASDBInputBatch Batch;
+		double FirstQueuedTime = 0.0;
+		float FlushInterval = 0.f;
+	};
+
+	/** A batch no receiver was registered for yet, e.g. because it overtook the ability activation */
+	struct FUnclaimedBatch
+	{
+		FGASDBInputBatch Batch;
+		bool bIsFinalState = false;
+		double ReceivedTime = 0.0;
+	};
+
+	/** Upper bound on unclaimed batches held per controller; the oldest is dropped when exceeded */
+	static constexpr int32 MaxUnclaimedBatches = 32;
+
+	struct FReceiver
+	{
+		FDelegateHandle Handle;
+		FGameplayAbilitySpecHandle AbilityHandle;
+		TWeakObjectPtr<const UInputAction> InputAction;
+		ETriggerEvent TriggerEvent = ETriggerEvent::None;
+		FGASDBOnForwardedInput Delegate;
+		uint16 LastSequence = 0;
+		bool bHasReceived = false;
+		bool bFinalStateReceived = false;
+	};
+
+	FPendingBatch* FindPendingBatch(FGameplayAbilitySpecHandle AbilityHandle, const UInputAction* InputAction, ETriggerEvent TriggerEvent);
+
+	void FlushPendingBatch(int32 PendingIndex);
+
+	/** Hands the batch to the matching receivers. @return False if no receiver is registered for its key. */
+	bool DispatchBatch(const FGASDBInputBatch& Batch, bool bIsFinalState);
+
+	/** Keeps a batch nobody was registered for, to be delivered once its receiver registers */
+	void AddUnclaimedBatch(const FGASDBInputBatch& Batch, bool bIsFinalState);
+
+	/** Delivers unclaimed batches whose receiver has registered since, in arrival order, and drops expired ones */
+	void DispatchUnclaimedBatches();
+
+	uint16 NextSequence = 0;
+
+	TArray<FPendingBatch> PendingBatches;
+
+	TArray<FReceiver> Receivers;
+
+	TArray<FUnclaimedBatch> UnclaimedBatches;
+};
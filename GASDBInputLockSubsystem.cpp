@@ -0,0 +1,262 @@
+#include "GASDBInputLockSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBInputLockSubsystem)
+
+UGASDBInputLockSubsystem* UGASDBInputLockSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASDBInputLockSubsystem>() : nullptr;
+}
+
+bool UGASDBInputLockSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+double UGASDBInputLockSubsystem::GetNow() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+FGASDBInputLockHandle UGASDBInputLockSubsystem::Lock(APlayerController* PlayerController, const EGASDBInputLockChannel Channels, const float Duration, const UObject* Reason, FGASDBOnInputLockReleased OnReleased)
+{
+	FGASDBInputLockHandle Handle;
+	if (!PlayerController || Channels == EGASDBInputLockChannel::None)
+	{
+		return Handle;
+	}
+
+	Handle.Id = NextLockId++;
+	if (NextLockId == 0)
+	{
+		NextLockId = 1;
+	}
+
+	FLockEntry& Entry = Locks.Add(Handle.Id);
+	Entry.Controller = PlayerController;
+	Entry.Reason = FObjectKey(Reason);
+	Entry.Channels = Channels;
+	Entry.OnReleased = MoveTemp(OnReleased);
+
+	if (Duration > 0.f)
+	{
+		Entry.ExpireTime = GetNow() + Duration;
+		ExpiryHeap.HeapPush(FExpiry{ Entry.ExpireTime, Handle.Id });
+	}
+
+	LocksByReason.FindOrAdd(Entry.Reason).Add(Handle.Id);
+
+	FControllerLockState& State = ControllerStates.FindOrAdd(PlayerController);
+	State.Controller = PlayerController;
+	ApplyChannels(State, Channels, true);
+
+	return Handle;
+}
+
+bool UGASDBInputLockSubsystem::Unlock(const FGASDBInputLockHandle Handle)
+{
+	FLockEntry* Entry = Locks.Find(Handle.Id);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	if (TArray<uint32, TInlineAllocator<2>>* ReasonLocks = LocksByReason.Find(Entry->Reason))
+	{
+		ReasonLocks->RemoveSingleSwap(Handle.Id, EAllowShrinking::No);
+		if (ReasonLocks->Num() == 0)
+		{
+			LocksByReason.Remove(Entry->Reason);
+		}
+	}
+
+	// Whoever holds the handle released it themselves, so the release callback is not run.
+	ReleaseEntry(Handle.Id, *Entry);
+	return true;
+}
+
+void UGASDBInputLockSubsystem::ClearReleaseCallback(const FGASDBInputLockHandle Handle)
+{
+	if (FLockEntry* Entry = Locks.Find(Handle.Id))
+	{
+		Entry->OnReleased.Unbind();
+	}
+}
+
+int32 UGASDBInputLockSubsystem::UnlockAllForReason(const UObject* Reason, const EGASDBInputLockChannel Channels, const APlayerController* PlayerController)
+{
+	const FObjectKey ReasonKey(Reason);
+	TArray<uint32, TInlineAllocator<2>>* ReasonLocks = LocksByReason.Find(ReasonKey);
+	if (!ReasonLocks)
+	{
+		return 0;
+	}
+
+	int32 NumReleased = 0;
+	TArray<FGASDBOnInputLockReleased, TInlineAllocator<2>> ReleasedCallbacks;
+	for (int32 Index = ReasonLocks->Num() - 1; Index >= 0; --Index)
+	{
+		const uint32 LockId = (*ReasonLocks)[Index];
+		FLockEntry* Entry = Locks.Find(LockId);
+		if (!Entry)
+		{
+			ReasonLocks->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		const EGASDBInputLockChannel Released = Entry->Channels & Channels;
+		if (Released == EGASDBInputLockChannel::None || (PlayerController && Entry->Controller != TObjectKey<APlayerController>(PlayerController)))
+		{
+			continue;
+		}
+
+		if (Released == Entry->Channels)
+		{
+			ReasonLocks->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			ReleasedCallbacks.Add(ReleaseEntry(LockId, *Entry));
+		}
+		else if (FControllerLockState* State = ControllerStates.Find(Entry->Controller))
+		{
+			// Only part of this request is being released; keep the remaining channels locked.
+			Entry->Channels &= ~Released;
+			ApplyChannels(*State, Released, false);
+		}
+		++NumReleased;
+	}
+
+	if (ReasonLocks->Num() == 0)
+	{
+		LocksByReason.Remove(ReasonKey);
+	}
+
+	for (const FGASDBOnInputLockReleased& Callback : ReleasedCallbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+	return NumReleased;
+}
+
+FGASDBOnInputLockReleased UGASDBInputLockSubsystem::ReleaseEntry(const uint32 LockId, FLockEntry& Entry)
+{
+	if (FControllerLockState* State = ControllerStates.Find(Entry.Controller))
+	{
+		ApplyChannels(*State, Entry.Channels, false);
+		if (State->MoveLockCount == 0 && State->LookLockCount == 0)
+		{
+			ControllerStates.Remove(Entry.Controller);
+		}
+	}
+
+	// Any expiry for this lock is left in the heap and skipped when it comes up.
+	FGASDBOnInputLockReleased OnReleased = MoveTemp(Entry.OnReleased);
+	Locks.Remove(LockId);
+	return OnReleased;
+}
+
+void UGASDBInputLockSubsystem::ApplyChannels(FControllerLockState& State, const EGASDBInputLockChannel Channels, const bool bLock)
+{
+	APlayerController* PlayerController = State.Controller.Get();
+	const int32 Delta = bLock ? 1 : -1;
+
+	if (EnumHasAnyFlags(Channels, EGASDBInputLockChannel::Move))
+	{
+		const bool bWasLocked = State.MoveLockCount > 0;
+		State.MoveLockCount = static_cast<uint16>(FMath::Max(State.MoveLockCount + Delta, 0));
+		const bool bIsLocked = State.MoveLockCount > 0;
+		if (bWasLocked != bIsLocked && PlayerController)
+		{
+			PlayerController->SetIgnoreMoveInput(bIsLocked);
+		}
+	}
+
+	if (EnumHasAnyFlags(Channels, EGASDBInputLockChannel::Look))
+	{
+		const bool bWasLocked = State.LookLockCount > 0;
+		State.LookLockCount = static_cast<uint16>(FMath::Max(State.LookLockCount + Delta, 0));
+		const bool bIsLocked = State.LookLockCount > 0;
+		if (bWasLocked != bIsLocked && PlayerController)
+		{
+			PlayerController->SetIgnoreLookInput(bIsLocked);
+		}
+	}
+}
+
+bool UGASDBInputLockSubsystem::IsLocked(const APlayerController* PlayerController, const EGASDBInputLockChannel Channel) const
+{
+	const FControllerLockState* State = ControllerStates.Find(PlayerController);
+	if (!State)
+	{
+		return false;
+	}
+
+	return (EnumHasAnyFlags(Channel, EGASDBInputLockChannel::Move) && State->MoveLockCount > 0)
+		|| (EnumHasAnyFlags(Channel, EGASDBInputLockChannel::Look) && State->LookLockCount > 0);
+}
+
+void UGASDBInputLockSubsystem::Tick(const float DeltaTime)
+{
+	const double Now = GetNow();
+	while (ExpiryHeap.Num() > 0 && ExpiryHeap.HeapTop().ExpireTime <= Now)
+	{
+		FExpiry Expiry;
+		ExpiryHeap.HeapPop(Expiry, EAllowShrinking::No);
+
+		// Skip locks that were released early or whose id was reused by a newer request.
+		FLockEntry* Entry = Locks.Find(Expiry.LockId);
+		if (!Entry || Entry->ExpireTime != Expiry.ExpireTime)
+		{
+			continue;
+		}
+
+		FGASDBOnInputLockReleased OnReleased = MoveTemp(Entry->OnReleased);
+		FGASDBInputLockHandle ExpiredHandle;
+		ExpiredHandle.Id = Expiry.LockId;
+		Unlock(ExpiredHandle);
+		OnReleased.ExecuteIfBound();
+	}
+}
+
+TStatId UGASDBInputLockSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASDBInputLockSubsystem, STATGROUP_Tickables);
+}
+
+void UGASDBInputLockSubsystem::Deinitialize()
+{
+	// Give the controllers back their input if the world goes away with locks still held.
+	for (TPair<TObjectKey<APlayerController>, FControllerLockState>& Pair : ControllerStates)
+	{
+		if (APlayerController* PlayerController = Pair.Value.Controller.Get())
+		{
+			if (Pair.Value.MoveLockCount > 0)
+			{
+				PlayerController->SetIgnoreMoveInput(false);
+			}
+			if (Pair.Value.LookLockCount > 0)
+			{
+				PlayerController->SetIgnoreLookInput(false);
+			}
+		}
+	}
+
+	Locks.Reset();
+	LocksByReason.Reset();
+	ControllerStates.Reset();
+	ExpiryHeap.Reset();
+
+	Super::Deinitialize();
+}
+
+FGASDBInputLockHandle UGASDBInputLockSubsystem::LockInput(const UObject* WorldContextObject, APlayerController* PlayerController, const int32 Channels, const float Duration, const UObject* Reason)
+{
+	UGASDBInputLockSubsystem* Subsystem = Get(WorldContextObject);
+	return Subsystem ? Subsystem->Lock(PlayerController, static_cast<EGASDBInputLockChannel>(Channels), Duration, Reason) : FGASDBInputLockHandle();
+}
+
+bool UGASDBInputLockSubsystem::UnlockInput(const UObject* WorldContextObject, const FGASDBInputLockHandle Handle)
+{
+	UGASDBInputLockSubsystem* Subsystem = Get(WorldContextObject);
+	return Subsystem && Subsystem->Unlock(Handle);
+}
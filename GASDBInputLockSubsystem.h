@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GASDBInputLockSubsystem.generated.h"
+
+class APlayerController;
+
+/** Which controller inputs a lock applies to. */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGASDBInputLockChannel : uint8
+{
+	None = 0 UMETA(Hidden),
+	Move = 1 << 0,
+	Look = 1 << 1,
+	All = Move | Look UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(EGASDBInputLockChannel);
+
+/** Identifies one lock request held by the input lock subsystem. */
+USTRUCT(BlueprintType)
+struct FGASDBInputLockHandle
+{
+	GENERATED_BODY()
+
+	bool IsValid() const { return Id != 0; }
+	void Reset() { Id = 0; }
+
+	bool operator==(const FGASDBInputLockHandle& Other) const { return Id == Other.Id; }
+
+	friend uint32 GetTypeHash(const FGASDBInputLockHandle& Handle) { return GetTypeHash(Handle.Id); }
+
+	UPROPERTY()
+	uint32 Id = 0;
+};
+
+/** Called once when a lock ends without its handle being unlocked: on expiry, or when UnlockAllForReason releases it. */
+DECLARE_DELEGATE(FGASDBOnInputLockReleased);
+
+/**
+ * Reference-counted move/look input locks for PlayerControllers.
+ *
+ * Every lock is a separate request tagged with a reason object (e.g. the ability system component or ability that asked for it). The controller
+ * only ignores an input while at least one request holds it, and SetIgnoreMoveInput/SetIgnoreLookInput are only called
+ * when that aggregate changes, so overlapping locks no longer clobber each other. Timed locks expire from a single
+ * min-heap checked once per frame instead of a timer per request.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBInputLockSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGASDBInputLockSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Adds a lock request.
+	 * @param PlayerController	The controller to lock.
+	 * @param Channels			The inputs to lock.
+	 * @param Duration			Seconds until the lock expires; zero or less keeps it until unlocked.
+	 * @param Reason			Object the lock is held for; UnlockAllForReason releases every lock it holds.
+	 * @param OnReleased		Optional callback when the lock expires or is released through its reason.
+	 */
+	FGASDBInputLockHandle Lock(APlayerController* PlayerController, EGASDBInputLockChannel Channels, float Duration, const UObject* Reason, FGASDBOnInputLockReleased OnReleased = FGASDBOnInputLockReleased());
+
+	/** Releases a single lock request. Returns false if it had already been released or expired. */
+	bool Unlock(FGASDBInputLockHandle Handle);
+
+	/** Keeps the lock but drops its release callback, e.g. when the object that bound it is going away. */
+	void ClearReleaseCallback(FGASDBInputLockHandle Handle);
+
+	/**
+	 * Releases every lock request held for Reason on the given channels, optionally only those on one controller (for
+	 * reasons shared between characters, e.g. a non-instanced ability). Returns the number of requests released.
+	 */
+	int32 UnlockAllForReason(const UObject* Reason, EGASDBInputLockChannel Channels = EGASDBInputLockChannel::All, const APlayerController* PlayerController = nullptr);
+
+	/** True if any request currently locks the given channel on the controller */
+	bool IsLocked(const APlayerController* PlayerController, EGASDBInputLockChannel Channel) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Ability|Input", meta = (WorldContext = "WorldContextObject", DefaultToSelf = "Reason"))
+	static FGASDBInputLockHandle LockInput(const UObject* WorldContextObject, APlayerController* PlayerController, UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/LyraGame.EGASDBInputLockChannel")) int32 Channels, float Duration, const UObject* Reason);
+
+	UFUNCTION(BlueprintCallable, Category = "Ability|Input", meta = (WorldContext = "WorldContextObject"))
+	static bool UnlockInput(const UObject* WorldContextObject, FGASDBInputLockHandle Handle);
+
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End UTickableWorldSubsystem Interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FLockEntry
+	{
+		TObjectKey<APlayerController> Controller;
+		FObjectKey Reason;
+		EGASDBInputLockChannel Channels = EGASDBInputLockChannel::None;
+		double ExpireTime = 0.0;
+		FGASDBOnInputLockReleased OnReleased;
+	};
+
+	struct FControllerLockState
+	{
+		TWeakObjectPtr<APlayerController> Controller;
+		uint16 MoveLockCount = 0;
+		uint16 LookLockCount = 0;
+	};
+
+	struct FExpiry
+	{
+		double ExpireTime = 0.0;
+		uint32 LockId = 0;
+
+		bool operator<(const FExpiry& Other) const { return ExpireTime < Other.ExpireTime; }
+	};
+
+	/** Adjusts the ref-counts and applies the controller state only on a 0 <-> 1 transition. */
+	void ApplyChannels(FControllerLockState& State, EGASDBInputLockChannel Channels, bool bLock);
+
+	/** Drops the entry and returns its release callback for the caller to run once the maps are consistent */
+	FGASDBOnInputLockReleased ReleaseEntry(uint32 LockId, FLockEntry& Entry);
+
+	double GetNow() const;
+
+	uint32 NextLockId = 1;
+
+	TMap<uint32, FLockEntry> Locks;
+
+	TMap<FObjectKey, TArray<uint32, TInlineAllocator<2>>> LocksByReason;
+
+	TMap<TObjectKey<APlayerController>, FControllerLockState> ControllerStates;
+
+	/** Min-heap of timed locks; entries for locks released early are skipped when popped */
+	TArray<FExpiry> ExpiryHeap;
+};
@@ -0,0 +1,288 @@
+#include "GASDBLatencyTracer.h"
+#include "Abilities/GameplayAbility.h"
+#include "GASDBDebug.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace GASDBLatency
+{
+	static bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("gasdb.Latency.Enable"),
+		bEnabled,
+		TEXT("Record input-to-effect latency for GASDB ability tasks."),
+		ECVF_Default);
+
+	/** Traces that never reach EffectApplied are dropped after this long */
+	static constexpr double StaleTraceSeconds = 10.0;
+	static constexpr int32 PruneThreshold = 1024;
+}
+
+void FGASDBLatencyHistogram::AddSample(const double Seconds)
+{
+	const double Micros = FMath::Max(Seconds * 1e6, 1.0);
+	const int32 Bucket = FMath::Min(FMath::FloorToInt32(FMath::Log2(Micros)), NumBuckets - 1);
+	++Buckets[Bucket];
+	++Count;
+	TotalSeconds += Seconds;
+	MinSeconds = FMath::Min(MinSeconds, Seconds);
+	MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+}
+
+double FGASDBLatencyHistogram::GetPercentileMs(const double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint64 Target = FMath::Max<uint64>(1, FMath::CeilToInt64(Percentile * Count));
+	uint64 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Target)
+		{
+			return FMath::Min(FMath::Pow(2.0, Bucket + 1) / 1000.0, MaxSeconds * 1000.0);
+		}
+	}
+	return MaxSeconds * 1000.0;
+}
+
+FGASDBLatencyTracer& FGASDBLatencyTracer::Get()
+{
+	static FGASDBLatencyTracer Instance;
+	return Instance;
+}
+
+bool FGASDBLatencyTracer::IsEnabled()
+{
+	return GASDBLatency::bEnabled;
+}
+
+const TCHAR* FGASDBLatencyTracer::LexSegment(const ESegment Segment)
+{
+	switch (Segment)
+	{
+	case ESegment::InputToActivation:		return TEXT("InputToActivation");
+	case ESegment::ActivationToSceneQuery:	return TEXT("ActivationToSceneQuery");
+	case ESegment::SceneQueryToEffect:		return TEXT("SceneQueryToEffect");
+	case ESegment::ActivationToEffect:		return TEXT("ActivationToEffect");
+	case ESegment::InputToEffect:			return TEXT("InputToEffect");
+	default:								return TEXT("Unknown");
+	}
+}
+
+FGASDBLatencyTracer::FOpenTrace& FGASDBLatencyTracer::OpenTrace(const UGameplayAbility* Ability)
+{
+	FOpenTrace& Trace = OpenTraces.Add(Ability);
+	Trace.CorrelationId = NextCorrelationId++;
+	Trace.AbilityName = Ability->GetClass()->GetFName();
+	Trace.OpenedTime = FPlatformTime::Seconds();
+	return Trace;
+}
+
+uint32 FGASDBLatencyTracer::BeginTrace(const UGameplayAbility* Ability, const double InputTimestamp)
+{
+	if (!Ability)
+	{
+		return 0;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (OpenTraces.Num() >= GASDBLatency::PruneThreshold)
+	{
+		PruneStaleTraces(Now);
+	}
+
+	// Input repeating before anything acted on it belongs to the pending trace; a stale one is replaced.
+	if (const FOpenTrace* Pending = OpenTraces.Find(Ability))
+	{
+		if (Now - Pending->OpenedTime < GASDBLatency::StaleTraceSeconds)
+		{
+			return Pending->CorrelationId;
+		}
+	}
+
+	FOpenTrace& Trace = OpenTrace(Ability);
+	Trace.Timestamps[static_cast<int32>(EGASDBLatencyStage::InputReceived)] = InputTimestamp;
+	Trace.StampedMask = 1 << static_cast<uint8>(EGASDBLatencyStage::InputReceived);
+	return Trace.CorrelationId;
+}
+
+uint32 FGASDBLatencyTracer::GetCorrelationId(const UGameplayAbility* Ability) const
+{
+	const FOpenTrace* Trace = Ability ? OpenTraces.Find(Ability) : nullptr;
+	return Trace ? Trace->CorrelationId : 0;
+}
+
+void FGASDBLatencyTracer::MarkStage(const UGameplayAbility* Ability, const EGASDBLatencyStage Stage)
+{
+	if (!Ability)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	FOpenTrace* Trace = OpenTraces.Find(Ability);
+	if (!Trace || (Stage == EGASDBLatencyStage::TaskActivated && Trace->HasStage(EGASDBLatencyStage::TaskActivated)))
+	{
+		// A task activated without a pending input (or a second task after a completed chain) starts its own trace.
+		if (Stage != EGASDBLatencyStage::TaskActivated)
+		{
+			return;
+		}
+		Trace = &OpenTrace(Ability);
+	}
+
+	Trace->Timestamps[static_cast<int32>(Stage)] = Now;
+	Trace->StampedMask |= 1 << static_cast<uint8>(Stage);
+
+	if (Stage == EGASDBLatencyStage::EffectApplied)
+	{
+		RecordClosedTrace(*Trace);
+		OpenTraces.Remove(Ability);
+	}
+}
+
+void FGASDBLatencyTracer::DiscardTrace(const UGameplayAbility* Ability)
+{
+	OpenTraces.Remove(Ability);
+}
+
+void FGASDBLatencyTracer::RecordClosedTrace(const FOpenTrace& Trace)
+{
+	FAbilityHistograms& AbilityHistograms = Histograms.FindOrAdd(Trace.AbilityName);
+
+	auto AddSegment = [&Trace, &AbilityHistograms](const ESegment Segment, const EGASDBLatencyStage From, const EGASDBLatencyStage To)
+	{
+		if (Trace.HasStage(From) && Trace.HasStage(To))
+		{
+			AbilityHistograms.Segments[static_cast<int32>(Segment)].AddSample(Trace.GetStage(To) - Trace.GetStage(From));
+		}
+	};
+
+	AddSegment(ESegment::InputToActivation, EGASDBLatencyStage::InputReceived, EGASDBLatencyStage::TaskActivated);
+	AddSegment(ESegment::ActivationToSceneQuery, EGASDBLatencyStage::TaskActivated, EGASDBLatencyStage::SceneQueryDone);
+	AddSegment(ESegment::SceneQueryToEffect, EGASDBLatencyStage::SceneQueryDone, EGASDBLatencyStage::EffectApplied);
+	AddSegment(ESegment::ActivationToEffect, EGASDBLatencyStage::TaskActivated, EGASDBLatencyStage::EffectApplied);
+	AddSegment(ESegment::InputToEffect, EGASDBLatencyStage::InputReceived, EGASDBLatencyStage::EffectApplied);
+
+	GASDB_LOG(nullptr, Verbose, TEXT("GASDB latency trace %u (%s) closed"), Trace.CorrelationId, *Trace.AbilityName.ToString());
+}
+
+void FGASDBLatencyTracer::PruneStaleTraces(const double Now)
+{
+	for (auto It = OpenTraces.CreateIterator(); It; ++It)
+	{
+		const FOpenTrace& Trace = It.Value();
+		double Newest = 0.0;
+		for (const double Timestamp : Trace.Timestamps)
+		{
+			Newest = FMath::Max(Newest, Timestamp);
+		}
+
+		if (Now - Newest > GASDBLatency::StaleTraceSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FGASDBLatencyTracer::Dump(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("GASDB latency: %d ability classes, %d open traces"), Histograms.Num(), OpenTraces.Num());
+	for (const TPair<FName, FAbilityHistograms>& Pair : Histograms)
+	{
+		Ar.Logf(TEXT("  %s"), *Pair.Key.ToString());
+		for (int32 SegmentIndex = 0; SegmentIndex < static_cast<int32>(ESegment::Num); ++SegmentIndex)
+		{
+			const FGASDBLatencyHistogram& Histogram = Pair.Value.Segments[SegmentIndex];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+
+			Ar.Logf(TEXT("    %-24s n=%-8llu mean=%.3fms min=%.3fms p50=%.3fms p90=%.3fms p99=%.3fms max=%.3fms"),
+				LexSegment(static_cast<ESegment>(SegmentIndex)), Histogram.Count,
+				Histogram.TotalSeconds * 1000.0 / Histogram.Count, Histogram.MinSeconds * 1000.0,
+				Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.9), Histogram.GetPercentileMs(0.99),
+				Histogram.MaxSeconds * 1000.0);
+		}
+	}
+}
+
+bool FGASDBLatencyTracer::ExportCSV(const FString& FilePath) const
+{
+	FString Csv = TEXT("Ability,Segment,Count,MeanMs,MinMs,P50Ms,P90Ms,P99Ms,MaxMs");
+	for (int32 Bucket = 0; Bucket < FGASDBLatencyHistogram::NumBuckets; ++Bucket)
+	{
+		Csv += FString::Printf(TEXT(",Lt%lluus"), 1ull << (Bucket + 1));
+	}
+	Csv += LINE_TERMINATOR;
+
+	for (const TPair<FName, FAbilityHistograms>& Pair : Histograms)
+	{
+		for (int32 SegmentIndex = 0; SegmentIndex < static_cast<int32>(ESegment::Num); ++SegmentIndex)
+		{
+			const FGASDBLatencyHistogram& Histogram = Pair.Value.Segments[SegmentIndex];
+			if (Histogram.Count == 0)
+			{
+				continue;
+			}
+
+			Csv += FString::Printf(TEXT("%s,%s,%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f"),
+				*Pair.Key.ToString(), LexSegment(static_cast<ESegment>(SegmentIndex)), Histogram.Count,
+				Histogram.TotalSeconds * 1000.0 / Histogram.Count, Histogram.MinSeconds * 1000.0,
+				Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.9), Histogram.GetPercentileMs(0.99),
+				Histogram.MaxSeconds * 1000.0);
+			for (const uint32 BucketCount : Histogram.Buckets)
+			{
+				Csv += FString::Printf(TEXT(",%u"), BucketCount);
+			}
+			Csv += LINE_TERMINATOR;
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+void FGASDBLatencyTracer::Reset()
+{
+	OpenTraces.Reset();
+	Histograms.Reset();
+}
+
+static FAutoConsoleCommandWithOutputDevice GASDBLatencyDumpCommand(
+	TEXT("gasdb.Latency.Dump"),
+	TEXT("Dumps GASDB input-to-effect latency histograms per ability."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		FGASDBLatencyTracer::Get().Dump(Ar);
+	}));
+
+static FAutoConsoleCommandWithArgsAndOutputDevice GASDBLatencyExportCommand(
+	TEXT("gasdb.Latency.ExportCSV"),
+	TEXT("Exports GASDB latency histograms to CSV. Optional argument: file path (defaults to Saved/Profiling/GASDBLatency.csv)."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const FString FilePath = Args.Num() > 0 ? Args[0] : FPaths::Combine(FPaths::ProfilingDir(), TEXT("GASDBLatency.csv"));
+		if (FGASDBLatencyTracer::Get().ExportCSV(FilePath))
+		{
+			Ar.Logf(TEXT("GASDB latency exported to %s"), *FilePath);
+		}
+		else
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GASDB latency export to %s failed"), *FilePath);
+		}
+	}));
+
+static FAutoConsoleCommand GASDBLatencyResetCommand(
+	TEXT("gasdb.Latency.Reset"),
+	TEXT("Clears GASDB latency histograms and open traces."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FGASDBLatencyTracer::Get().Reset();
+	}));
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UGameplayAbility;
+
+/** Points in the life of an input-driven action that the latency tracer timestamps. */
+enum class EGASDBLatencyStage : uint8
+{
+	/** WaitEnhancedInputEvent received the input */
+	InputReceived,
+	/** A movement, teleport or spawn task was activated */
+	TaskActivated,
+	/** The task's collision / encroachment queries finished */
+	SceneQueryDone,
+	/** The move, teleport or spawn was applied to the world */
+	EffectApplied,
+
+	Num
+};
+
+/** Log2 histogram of latencies in microseconds. Bucket N holds samples in [2^N, 2^(N+1)) us. */
+struct FGASDBLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 24;
+
+	void AddSample(double Seconds);
+
+	/** Approximate percentile (0-1) in milliseconds, taken from the upper edge of the matching bucket */
+	double GetPercentileMs(double Percentile) const;
+
+	uint32 Buckets[NumBuckets] = {};
+	uint64 Count = 0;
+	double TotalSeconds = 0.0;
+	double MinSeconds = TNumericLimits<double>::Max();
+	double MaxSeconds = 0.0;
+};
+
+/**
+ * Opt-in input-to-effect latency tracing for the GASDB tasks (gasdb.Latency.Enable 1).
+ *
+ * Every input or task activation opens a trace for the owning ability with a correlation ID; later tasks of the same
+ * ability stamp their stages on it and the trace is closed when the effect is applied. The ID is handed out with the
+ * input event (UAbilityTask_WaitEnhancedInputEvent::GetLatencyCorrelationId, FGASDBInputEventEntry) and can be looked
+ * up per ability with GetCorrelationId while the trace is open. Stage-to-stage latencies are accumulated per ability
+ * class and can be dumped with gasdb.Latency.Dump or exported with gasdb.Latency.ExportCSV.
+ * Game thread only.
+ */
+class LYRAGAME_API FGASDBLatencyTracer
+{
+public:
+	/** Latency segments recorded per ability class */
+	enum class ESegment : uint8
+	{
+		InputToActivation,
+		ActivationToSceneQuery,
+		SceneQueryToEffect,
+		ActivationToEffect,
+		InputToEffect,
+
+		Num
+	};
+
+	static FGASDBLatencyTracer& Get();
+
+	static bool IsEnabled();
+
+	/**
+	 * Opens a new trace for the ability at InputTimestamp (FPlatformTime::Seconds) and returns its correlation ID. If the
+	 * ability already has a trace pending, e.g. a held input reporting Triggered every frame, that trace is kept and its
+	 * ID returned, so InputToEffect is measured from the first input.
+	 */
+	uint32 BeginTrace(const UGameplayAbility* Ability, double InputTimestamp);
+
+	/** Correlation ID of the ability's open trace, or 0 if none is open. */
+	uint32 GetCorrelationId(const UGameplayAbility* Ability) const;
+
+	/** Stamps a stage on the ability's open trace. TaskActivated opens a trace if none is open; EffectApplied closes it. */
+	void MarkStage(const UGameplayAbility* Ability, EGASDBLatencyStage Stage);
+
+	/** Drops the ability's open trace without recording it, e.g. when the task failed. */
+	void DiscardTrace(const UGameplayAbility* Ability);
+
+	void Dump(FOutputDevice& Ar) const;
+
+	bool ExportCSV(const FString& FilePath) const;
+
+	void Reset();
+
+	static const TCHAR* LexSegment(ESegment Segment);
+
+private:
+	struct FOpenTrace
+	{
+		uint32 CorrelationId = 0;
+		FName AbilityName;
+		double Timestamps[static_cast<int32>(EGASDBLatencyStage::Num)] = {};
+		uint8 StampedMask = 0;
+
+		/** When the trace was opened, for pruning */
+		double OpenedTime = 0.0;
+
+		bool HasStage(EGASDBLatencyStage Stage) const { return (StampedMask & (1 << static_cast<uint8>(Stage))) != 0; }
+		double GetStage(EGASDBLatencyStage Stage) const { return Timestamps[static_cast<int32>(Stage)]; }
+	};
+
+	struct FAbilityHistograms
+	{
+		FGASDBLatencyHistogram Segments[static_cast<int32>(ESegment::Num)];
+	};
+
+	FOpenTrace& OpenTrace(const UGameplayAbility* Ability);
+
+	void RecordClosedTrace(const FOpenTrace& Trace);
+
+	void PruneStaleTraces(double Now);
+
+	uint32 NextCorrelationId = 1;
+
+	TMap<TObjectKey<UGameplayAbility>, FOpenTrace> OpenTraces;
+
+	TMap<FName, FAbilityHistograms> Histograms;
+};
+
+/** Cheap when tracing is disabled: a single bool test. */
+#define GASDB_LATENCY_STAGE(AbilityPtr, Stage) \
+	do { if (FGASDBLatencyTracer::IsEnabled()) { FGASDBLatencyTracer::Get().MarkStage(AbilityPtr, EGASDBLatencyStage::Stage); } } while (0)
+
+#define GASDB_LATENCY_DISCARD(AbilityPtr) \
+	do { if (FGASDBLatencyTracer::IsEnabled()) { FGASDBLatencyTracer::Get().DiscardTrace(AbilityPtr); } } while (0)
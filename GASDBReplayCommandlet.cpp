@@ -0,0 +1,116 @@
+#include "GASDBReplayCommandlet.h"
+#include "GASDBDebug.h"
+#include "GASDBTaskHarness.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBReplayCommandlet)
+
+namespace GASDBReplay
+{
+	/** Frame time at Percentile (0..1) of an ascending array of milliseconds */
+	static double GetPercentile(const TArray<double>& SortedFrameMs, const double Percentile)
+	{
+		if (SortedFrameMs.Num() == 0)
+		{
+			return 0.0;
+		}
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedFrameMs.Num()) - 1, 0, SortedFrameMs.Num() - 1);
+		return SortedFrameMs[Index];
+	}
+}
+
+UGASDBReplayCommandlet::UGASDBReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGASDBReplayCommandlet::Main(const FString& Params)
+{
+	using namespace GASDBReplay;
+
+	FString RecordingPath;
+	FString MapPackageName;
+	float FixedDeltaSeconds = 1.f / 60.f;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("GASDBReplay.csv");
+	FParse::Value(*Params, TEXT("File="), RecordingPath);
+	FParse::Value(*Params, TEXT("Map="), MapPackageName);
+	FParse::Value(*Params, TEXT("FixedDelta="), FixedDeltaSeconds);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FixedDeltaSeconds = FMath::Max(FixedDeltaSeconds, 0.001f);
+
+	if (RecordingPath.IsEmpty())
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBReplay: pass the recording with -File=<path>."));
+		return 1;
+	}
+
+	FGASDBTaskHarness Harness;
+	if (!Harness.Initialize(MapPackageName))
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBReplay: could not create a world."));
+		return 1;
+	}
+
+	FGASDBTaskReplayer Replayer;
+	FString LoadError;
+	if (!Replayer.Load(RecordingPath, LoadError))
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBReplay: %s"), *LoadError);
+		return 1;
+	}
+
+	Replayer.SpawnAvatars(Harness);
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDBReplay: %d tasks on %d avatars over %.1fs of recording"),
+		Replayer.GetNumTaskEvents(), Harness.GetNumAvatars(), Replayer.GetDuration());
+
+	FString Csv = TEXT("frame,sim_seconds,frame_ms,scene_queries,tasks_created,live_tasks\n");
+	TArray<double> FrameMs;
+	FrameMs.Reserve(FMath::CeilToInt32(Replayer.GetDuration() / FixedDeltaSeconds) + 1);
+
+	const uint64 StartSceneQueries = FGASDBTaskMetrics::Get().NumSceneQueries;
+	double SimSeconds = 0.0;
+	int32 Frame = 0;
+
+	// Frame cost includes creating the frame's tasks, as it did in the recorded session. Tasks still alive when the
+	// recording stopped are not waited for; they end with the world.
+	while (!Replayer.IsFinished())
+	{
+		const uint64 SceneQueriesBefore = FGASDBTaskMetrics::Get().NumSceneQueries;
+		const double StartTime = FPlatformTime::Seconds();
+		const int32 NumCreated = Replayer.Advance(Harness, SimSeconds);
+		Harness.TickWorld(FixedDeltaSeconds);
+		const double TickMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		Csv += FString::Printf(TEXT("%d,%.4f,%.4f,%llu,%d,%d\n"), Frame, SimSeconds, TickMs,
+			FGASDBTaskMetrics::Get().NumSceneQueries - SceneQueriesBefore, NumCreated, Replayer.GetNumLiveTasks());
+		FrameMs.Add(TickMs);
+
+		SimSeconds += FixedDeltaSeconds;
+		++Frame;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBReplay: could not write %s"), *OutputPath);
+		return 1;
+	}
+
+	double TotalMs = 0.0;
+	for (const double Ms : FrameMs)
+	{
+		TotalMs += Ms;
+	}
+	FrameMs.Sort();
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDBReplay: %d frames, frame ms avg=%.4f p50=%.4f p95=%.4f p99=%.4f max=%.4f, %llu scene queries. Frames in %s"),
+		Frame, Frame > 0 ? TotalMs / Frame : 0.0, GetPercentile(FrameMs, 0.5), GetPercentile(FrameMs, 0.95), GetPercentile(FrameMs, 0.99),
+		FrameMs.Num() > 0 ? FrameMs.Last() : 0.0, FGASDBTaskMetrics::Get().NumSceneQueries - StartSceneQueries, *OutputPath);
+	return 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASDBReplayCommandlet.generated.h"
+
+/**
+ * Replays a task stream recorded with gasdb.Record.Start on a headless world, so a real gameplay session can be
+ * re-run on every build and compared frame by frame.
+ *
+ *   UnrealEditor-Cmd <Project> -run=GASDBReplay -nullrhi -unattended -File=<recording> [-Map=/Game/Maps/Arena]
+ *       [-FixedDelta=0.016667] [-Output=<path>]
+ *
+ * Tasks are created through the same factories, with the recorded parameters, at the same offsets from the start of
+ * the recording, on one harness avatar per recorded avatar. The world advances in fixed steps so runs are comparable.
+ * Per-frame tick time, scene queries, created and live tasks go to a CSV (by default Saved/Profiling/GASDBReplay.csv)
+ * and frame time percentiles to the log. Actors spawned by replayed SpawnSafeActor tasks stay in the world, as they did
+ * in the recorded session.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGASDBReplayCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,330 @@
+#include "GASDBSimulatedTaskSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilityTask_OnTickEvent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GASDBTaskMetrics.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBSimulatedTaskSubsystem)
+
+namespace GASDBSimulatedTasks
+{
+	static float MaxDistance = 0.f;
+	static FAutoConsoleVariableRef CVarMaxDistance(
+		TEXT("gasdb.SimulatedTasks.MaxDistance"),
+		MaxDistance,
+		TEXT("Relevancy-mode simulated tasks only run for viewers within this distance of the avatar. 0 means net relevancy alone decides."),
+		ECVF_Default);
+
+	static bool bRequireLineOfSight = false;
+	static FAutoConsoleVariableRef CVarRequireLineOfSight(
+		TEXT("gasdb.SimulatedTasks.RequireLineOfSight"),
+		bRequireLineOfSight,
+		TEXT("Relevancy-mode simulated tasks also need the avatar to be visible: a line of sight trace on the server, recently rendered on clients."),
+		ECVF_Default);
+
+	static float UpdateInterval = 0.25f;
+	static FAutoConsoleVariableRef CVarUpdateInterval(
+		TEXT("gasdb.SimulatedTasks.UpdateInterval"),
+		UpdateInterval,
+		TEXT("Seconds between relevancy updates of relevancy-mode simulated tasks."),
+		ECVF_Default);
+
+	/** Extra distance allowed to a viewer already running the task, so it does not flap at the edge */
+	static constexpr float DistanceHysteresis = 1.1f;
+
+	static bool IsWithinDistance(const AActor* Avatar, const FVector& ViewLocation, const bool bCurrentlyRunning)
+	{
+		if (MaxDistance <= 0.f)
+		{
+			return true;
+		}
+
+		const float Limit = bCurrentlyRunning ? MaxDistance * DistanceHysteresis : MaxDistance;
+		return FVector::DistSquared(Avatar->GetActorLocation(), ViewLocation) <= FMath::Square(Limit);
+	}
+}
+
+UGASDBSimulatedTaskSubsystem* UGASDBSimulatedTaskSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASDBSimulatedTaskSubsystem>() : nullptr;
+}
+
+bool UGASDBSimulatedTaskSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGASDBSimulatedTaskSubsystem::RegisterServerTask(UAbilityTask_OnTickEvent* Task)
+{
+	// Nothing replicates in standalone, and a client never owns the registration.
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	if (Task && NetMode != NM_Standalone && NetMode != NM_Client)
+	{
+		PendingServerTasks.Add(Task);
+	}
+}
+
+void UGASDBSimulatedTaskSubsystem::RegisterClientTask(UAbilityTask_OnTickEvent* Task)
+{
+	if (Task)
+	{
+		ClientTasks.Add(Task);
+	}
+}
+
+void UGASDBSimulatedTaskSubsystem::Tick(const float DeltaTime)
+{
+	// New tasks have to leave their default registration before the net driver next replicates their component.
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate > 0.0 && PendingServerTasks.Num() == 0)
+	{
+		return;
+	}
+	TimeUntilUpdate = GASDBSimulatedTasks::UpdateInterval;
+
+	GASDB_SCOPE(SimulatedTasks_Update);
+
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		UpdateClient();
+	}
+	else
+	{
+		UpdateServer();
+	}
+}
+
+bool UGASDBSimulatedTaskSubsystem::MoveToNetGroup(UAbilityTask_OnTickEvent* Task, FServerAvatar& Entry)
+{
+	UAbilitySystemComponent* ASC = Task->AbilitySystemComponent.Get();
+	if (!ASC || !ASC->IsUsingRegisteredSubObjectList() || !ASC->IsReplicatedSubObjectRegistered(Task))
+	{
+		return false;
+	}
+
+	// The tasks component registered it as COND_SkipOwner when it became a simulated task.
+	ASC->RemoveReplicatedSubObject(Task);
+	ASC->AddReplicatedSubObject(Task, COND_NetGroup);
+	UE::Net::FNetConditionGroupManager::RegisterSubObjectInGroup(Task, Entry.NetGroup);
+	Task->RelevancyNetGroup = Entry.NetGroup;
+	return true;
+}
+
+bool UGASDBSimulatedTaskSubsystem::ShouldReplicateTo(const APlayerController* PlayerController, const AActor* Avatar, const bool bCurrentlyIncluded) const
+{
+	if (PlayerController->GetPawn() == Avatar)
+	{
+		return false;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	const AActor* ViewTarget = PlayerController->GetViewTarget();
+	if (!Avatar->IsNetRelevantFor(PlayerController, ViewTarget ? ViewTarget : PlayerController, ViewLocation))
+	{
+		return false;
+	}
+
+	if (!GASDBSimulatedTasks::IsWithinDistance(Avatar, ViewLocation, bCurrentlyIncluded))
+	{
+		return false;
+	}
+
+	if (GASDBSimulatedTasks::bRequireLineOfSight)
+	{
+		GASDB_COUNT_SCENE_QUERY();
+		return PlayerController->LineOfSightTo(Avatar, ViewLocation);
+	}
+	return true;
+}
+
+void UGASDBSimulatedTaskSubsystem::UpdateServer()
+{
+	for (const TWeakObjectPtr<UAbilityTask_OnTickEvent>& WeakTask : PendingServerTasks)
+	{
+		UAbilityTask_OnTickEvent* Task = WeakTask.Get();
+		AActor* Avatar = Task && !Task->IsFinished() ? Task->GetAvatarActor() : nullptr;
+		if (!Avatar)
+		{
+			continue;
+		}
+
+		FServerAvatar& Entry = ServerAvatars.FindOrAdd(Avatar);
+		if (Entry.NetGroup.IsNone())
+		{
+			// A numbered name, so avatars coming and going do not grow the name table.
+			Entry.Avatar = Avatar;
+			Entry.NetGroup = FName(TEXT("GASDBSimulatedTasks"), static_cast<int32>(Avatar->GetUniqueID()));
+		}
+
+		// Components without a registered subobject list keep replicating the task to everyone.
+		if (MoveToNetGroup(Task, Entry))
+		{
+			Entry.Tasks.Add(Task);
+		}
+	}
+	PendingServerTasks.Reset();
+
+	TasksPerConnection.Reset();
+	for (auto It = ServerAvatars.CreateIterator(); It; ++It)
+	{
+		FServerAvatar& Entry = It.Value();
+		Entry.Tasks.RemoveAllSwap([](const TWeakObjectPtr<UAbilityTask_OnTickEvent>& Task)
+		{
+			return !Task.IsValid() || Task->IsFinished();
+		}, EAllowShrinking::No);
+
+		const AActor* Avatar = Entry.Avatar.Get();
+		if (!Avatar || Entry.Tasks.Num() == 0)
+		{
+			RemoveAvatar(Entry);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		for (auto ControllerIt = Entry.IncludedControllers.CreateIterator(); ControllerIt; ++ControllerIt)
+		{
+			if (!ControllerIt->ResolveObjectPtr())
+			{
+				ControllerIt.RemoveCurrent();
+			}
+		}
+
+		for (FConstPlayerControllerIterator ControllerIt = GetWorld()->GetPlayerControllerIterator(); ControllerIt; ++ControllerIt)
+		{
+			// A listen server's own player sees the authoritative tasks.
+			APlayerController* PlayerController = ControllerIt->Get();
+			if (!PlayerController || PlayerController->IsLocalController())
+			{
+				continue;
+			}
+
+			const bool bIncluded = Entry.IncludedControllers.Contains(PlayerController);
+			const bool bShouldInclude = ShouldReplicateTo(PlayerController, Avatar, bIncluded);
+			if (bShouldInclude && !bIncluded)
+			{
+				PlayerController->IncludeInNetConditionGroup(Entry.NetGroup);
+				Entry.IncludedControllers.Add(PlayerController);
+			}
+			else if (!bShouldInclude && bIncluded)
+			{
+				PlayerController->RemoveFromNetConditionGroup(Entry.NetGroup);
+				Entry.IncludedControllers.Remove(PlayerController);
+			}
+
+			if (bShouldInclude)
+			{
+				TasksPerConnection.FindOrAdd(PlayerController) += Entry.Tasks.Num();
+			}
+		}
+	}
+}
+
+void UGASDBSimulatedTaskSubsystem::RemoveAvatar(FServerAvatar& Entry)
+{
+	for (const TObjectKey<APlayerController>& ControllerKey : Entry.IncludedControllers)
+	{
+		if (APlayerController* PlayerController = ControllerKey.ResolveObjectPtr())
+		{
+			PlayerController->RemoveFromNetConditionGroup(Entry.NetGroup);
+		}
+	}
+	Entry.IncludedControllers.Reset();
+}
+
+void UGASDBSimulatedTaskSubsystem::UpdateClient()
+{
+	ClientTasks.RemoveAllSwap([](const TWeakObjectPtr<UAbilityTask_OnTickEvent>& Task)
+	{
+		return !Task.IsValid() || Task->IsFinished();
+	}, EAllowShrinking::No);
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	for (const TWeakObjectPtr<UAbilityTask_OnTickEvent>& WeakTask : ClientTasks)
+	{
+		UAbilityTask_OnTickEvent* Task = WeakTask.Get();
+		const AActor* Avatar = Task->GetAvatarActor();
+
+		bool bShouldRun = Avatar && GASDBSimulatedTasks::IsWithinDistance(Avatar, ViewLocation, !Task->bSimulationPaused);
+		if (bShouldRun && GASDBSimulatedTasks::bRequireLineOfSight)
+		{
+			bShouldRun = Avatar->WasRecentlyRendered(0.5f);
+		}
+		Task->bSimulationPaused = !bShouldRun;
+	}
+}
+
+void UGASDBSimulatedTaskSubsystem::Dump(FOutputDevice& Ar) const
+{
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		int32 NumPaused = 0;
+		for (const TWeakObjectPtr<UAbilityTask_OnTickEvent>& Task : ClientTasks)
+		{
+			NumPaused += Task.IsValid() && Task->bSimulationPaused ? 1 : 0;
+		}
+		Ar.Logf(TEXT("GASDB relevancy-mode simulated tasks: %d running, %d paused"), ClientTasks.Num() - NumPaused, NumPaused);
+		return;
+	}
+
+	int32 NumTasks = 0;
+	for (const TPair<TObjectKey<AActor>, FServerAvatar>& Pair : ServerAvatars)
+	{
+		NumTasks += Pair.Value.Tasks.Num();
+	}
+	Ar.Logf(TEXT("GASDB relevancy-mode simulated tasks: %d on %d avatars"), NumTasks, ServerAvatars.Num());
+
+	for (FConstPlayerControllerIterator ControllerIt = GetWorld()->GetPlayerControllerIterator(); ControllerIt; ++ControllerIt)
+	{
+		const APlayerController* PlayerController = ControllerIt->Get();
+		if (PlayerController && !PlayerController->IsLocalController())
+		{
+			const int32* NumReplicated = TasksPerConnection.Find(PlayerController);
+			Ar.Logf(TEXT("  %-40s %6d"), *PlayerController->GetName(), NumReplicated ? *NumReplicated : 0);
+		}
+	}
+}
+
+TStatId UGASDBSimulatedTaskSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASDBSimulatedTaskSubsystem, STATGROUP_Tickables);
+}
+
+void UGASDBSimulatedTaskSubsystem::Deinitialize()
+{
+	for (TPair<TObjectKey<AActor>, FServerAvatar>& Pair : ServerAvatars)
+	{
+		RemoveAvatar(Pair.Value);
+	}
+	ServerAvatars.Reset();
+	PendingServerTasks.Reset();
+	TasksPerConnection.Reset();
+	ClientTasks.Reset();
+
+	Super::Deinitialize();
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GASDBSimulatedTasksDumpCommand(
+	TEXT("gasdb.SimulatedTasks.Dump"),
+	TEXT("Prints how many relevancy-mode simulated GASDB tasks each connection is running (server) or how many run and are paused (client)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UGASDBSimulatedTaskSubsystem* Subsystem = UGASDBSimulatedTaskSubsystem::Get(World))
+		{
+			Subsystem->Dump(Ar);
+		}
+	}));
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "GASDBSimulatedTaskSubsystem.generated.h"
+
+class APlayerController;
+class UAbilityTask_OnTickEvent;
+
+/**
+ * Limits relevancy-mode simulated ticking tasks (UAbilityTask_OnTickEvent::OnTickEventWhenRelevant) to the clients that
+ * can see their avatar.
+ *
+ * On the server each such task is moved to a COND_NetGroup subobject registration with one net condition group per
+ * avatar, and every remote PlayerController is added to or removed from an avatar's group as the avatar becomes or
+ * stops being net relevant, within gasdb.SimulatedTasks.MaxDistance and, with gasdb.SimulatedTasks.RequireLineOfSight,
+ * in line of sight of the connection's view point. The owning client is never included; it runs its own copy.
+ *
+ * A client keeps the copies it already received when the server stops sending them, so on clients the subsystem
+ * pauses those whose avatar is out of range or was not rendered recently and resumes them when it is again.
+ *
+ * Relevancy is re-evaluated every gasdb.SimulatedTasks.UpdateInterval seconds. gasdb.SimulatedTasks.Dump prints how
+ * many relevancy-mode tasks each connection is running.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBSimulatedTaskSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGASDBSimulatedTaskSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Server: called when a relevancy-mode task activates. It is moved to its avatar's net group on the next update. */
+	void RegisterServerTask(UAbilityTask_OnTickEvent* Task);
+
+	/** Client: called when a relevancy-mode task is created from replication */
+	void RegisterClientTask(UAbilityTask_OnTickEvent* Task);
+
+	/** Prints per-connection task counts on a server, running and paused counts on a client */
+	void Dump(FOutputDevice& Ar) const;
+
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End UTickableWorldSubsystem Interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FServerAvatar
+	{
+		TWeakObjectPtr<AActor> Avatar;
+		FName NetGroup;
+		TArray<TWeakObjectPtr<UAbilityTask_OnTickEvent>> Tasks;
+		TSet<TObjectKey<APlayerController>> IncludedControllers;
+	};
+
+	void UpdateServer();
+
+	void UpdateClient();
+
+	/** Moves a pending task to COND_NetGroup replication. False if its component does not use the registered subobject list. */
+	bool MoveToNetGroup(UAbilityTask_OnTickEvent* Task, FServerAvatar& Entry);
+
+	/** Whether Avatar's simulated tasks should replicate to PlayerController */
+	bool ShouldReplicateTo(const APlayerController* PlayerController, const AActor* Avatar, bool bCurrentlyIncluded) const;
+
+	void RemoveAvatar(FServerAvatar& Entry);
+
+	TArray<TWeakObjectPtr<UAbilityTask_OnTickEvent>> PendingServerTasks;
+
+	TMap<TObjectKey<AActor>, FServerAvatar> ServerAvatars;
+
+	/** Relevancy-mode tasks each connection received as of the last update */
+	TMap<TObjectKey<APlayerController>, int32> TasksPerConnection;
+
+	TArray<TWeakObjectPtr<UAbilityTask_OnTickEvent>> ClientTasks;
+
+	double TimeUntilUpdate = 0.0;
+};
@@ -0,0 +1,362 @@
+#include "GASDBSoakCommandlet.h"
+#include "AbilityTask_InputLock.h"
+#include "AbilityTask_InstantMoveToLocation.h"
+#include "AbilityTask_MoveInDirection.h"
+#include "AbilityTask_MoveRandomly.h"
+#include "AbilityTask_OnTickEvent.h"
+#include "AbilityTask_RunTaskSequence.h"
+#include "AbilityTask_SpawnSafeActor.h"
+#include "GASDBDebug.h"
+#include "GASDBTaskHarness.h"
+#include "GASDBTaskMetrics.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBSoakCommandlet)
+
+namespace GASDBSoak
+{
+	static constexpr float FrameDeltaSeconds = 1.f / 60.f;
+
+	enum class ETaskType : uint8
+	{
+		OnTickEvent,
+		MoveRandomly,
+		MoveInDirection,
+		InstantMove,
+		SpawnSafeActor,
+		InputLock,
+		RunTaskSequence,
+
+		Num
+	};
+
+	/** Counts consecutive samples in which a metric grew by more than Tolerance */
+	struct FGrowthTracker
+	{
+		FGrowthTracker(const TCHAR* InName, double InTolerance)
+			: Name(InName)
+			, Tolerance(InTolerance)
+		{
+		}
+
+		/** Returns true once the metric has grown in Window consecutive samples */
+		bool AddSample(double Value, int32 Window)
+		{
+			if (bHasLast && Value > LastValue + Tolerance)
+			{
+				++Streak;
+			}
+			else
+			{
+				Streak = 0;
+			}
+			LastValue = Value;
+			bHasLast = true;
+			return Streak >= Window;
+		}
+
+		const TCHAR* Name;
+		double Tolerance;
+		double LastValue = 0.0;
+		int32 Streak = 0;
+		bool bHasLast = false;
+	};
+
+	static int32 CountLiveTaskObjects()
+	{
+		int32 NumTasks = 0;
+		for (TObjectIterator<UAbilityTask> It; It; ++It)
+		{
+			++NumTasks;
+		}
+		return NumTasks;
+	}
+}
+
+UGASDBSoakCommandlet::UGASDBSoakCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGASDBSoakCommandlet::Main(const FString& Params)
+{
+	using namespace GASDBSoak;
+
+	double DurationSeconds = 3600.0;
+	float TasksPerSecond = 2000.f;
+	int32 NumAvatars = 256;
+	float CancelFraction = 0.25f;
+	float AbilityCancelsPerSecond = 50.f;
+	double SampleIntervalSeconds = 30.0;
+	int32 WarmupSamples = 3;
+	int32 GrowthWindow = 8;
+	double MemoryToleranceMB = 1.0;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Profiling") / TEXT("GASDBSoak.csv");
+	FParse::Value(*Params, TEXT("Duration="), DurationSeconds);
+	FParse::Value(*Params, TEXT("Rate="), TasksPerSecond);
+	FParse::Value(*Params, TEXT("Avatars="), NumAvatars);
+	FParse::Value(*Params, TEXT("CancelFraction="), CancelFraction);
+	FParse::Value(*Params, TEXT("AbilityCancels="), AbilityCancelsPerSecond);
+	FParse::Value(*Params, TEXT("SampleInterval="), SampleIntervalSeconds);
+	FParse::Value(*Params, TEXT("WarmupSamples="), WarmupSamples);
+	FParse::Value(*Params, TEXT("GrowthWindow="), GrowthWindow);
+	FParse::Value(*Params, TEXT("MemoryTolerance="), MemoryToleranceMB);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	NumAvatars = FMath::Max(1, NumAvatars);
+	GrowthWindow = FMath::Max(2, GrowthWindow);
+	CancelFraction = FMath::Clamp(CancelFraction, 0.f, 1.f);
+
+	FGASDBTaskHarness Harness;
+	if (!Harness.Initialize())
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBSoak: could not create a world."));
+		return 1;
+	}
+
+	Harness.SpawnAvatars(NumAvatars);
+	if (Harness.GetNumAvatars() < NumAvatars)
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBSoak: spawned %d of %d avatars."), Harness.GetNumAvatars(), NumAvatars);
+		return 1;
+	}
+
+	FMath::RandInit(0x50A4);
+
+	FString Csv = TEXT("wall_seconds,sim_seconds,frames,tasks_created,tasks_cancelled,ability_cancels,live_tracked_tasks,live_task_timers,live_task_objects,used_physical_mb,avg_frame_ms\n");
+
+	FGrowthTracker Timers(TEXT("live task timers"), 0.0);
+	FGrowthTracker TaskObjects(TEXT("live task UObjects"), 0.0);
+	FGrowthTracker Memory(TEXT("used physical memory (MB)"), MemoryToleranceMB);
+
+	const double StartTime = FPlatformTime::Seconds();
+	double NextSampleTime = StartTime + SampleIntervalSeconds;
+	double SimSeconds = 0.0;
+	uint64 NumFrames = 0;
+	double FrameSecondsSinceSample = 0.0;
+	uint64 FramesSinceSample = 0;
+	float PendingCreates = 0.f;
+	float PendingAbilityCancels = 0.f;
+	int32 NumSamples = 0;
+	FString FailureReason;
+
+	while (FailureReason.IsEmpty() && FPlatformTime::Seconds() - StartTime < DurationSeconds)
+	{
+		PendingCreates += TasksPerSecond * FrameDeltaSeconds;
+		int32 NumCreatedThisFrame = 0;
+		while (PendingCreates >= 1.f)
+		{
+			CreateTask(Harness);
+			PendingCreates -= 1.f;
+			++NumCreatedThisFrame;
+		}
+
+		const int32 NumToCancel = FMath::RoundToInt32(NumCreatedThisFrame * CancelFraction);
+		for (int32 Index = 0; Index < NumToCancel; ++Index)
+		{
+			CancelRandomTask();
+		}
+
+		PendingAbilityCancels += AbilityCancelsPerSecond * FrameDeltaSeconds;
+		while (PendingAbilityCancels >= 1.f)
+		{
+			if (!Harness.CancelAndReactivateAbility(FMath::RandRange(0, Harness.GetNumAvatars() - 1)))
+			{
+				FailureReason = TEXT("an ability could not be reactivated after being cancelled");
+			}
+			PendingAbilityCancels -= 1.f;
+			++NumAbilityCancels;
+		}
+
+		FrameSecondsSinceSample += Harness.TickWorld(FrameDeltaSeconds);
+		++FramesSinceSample;
+		++NumFrames;
+		SimSeconds += FrameDeltaSeconds;
+
+		DestroySpawnedActors();
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now < NextSampleTime)
+		{
+			continue;
+		}
+		NextSampleTime = Now + SampleIntervalSeconds;
+
+		LiveTasks.RemoveAllSwap([](const TWeakObjectPtr<UAbilityTask>& Task)
+		{
+			return !Task.IsValid() || Task->IsFinished();
+		}, EAllowShrinking::No);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		const int64 LiveTimers = FGASDBTaskMetrics::Get().NumLiveTimers;
+		const int32 LiveTaskObjects = CountLiveTaskObjects();
+		const double UsedPhysicalMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+		const double AvgFrameMs = FramesSinceSample > 0 ? FrameSecondsSinceSample * 1000.0 / FramesSinceSample : 0.0;
+		FrameSecondsSinceSample = 0.0;
+		FramesSinceSample = 0;
+
+		Csv += FString::Printf(TEXT("%.1f,%.1f,%llu,%llu,%llu,%llu,%d,%lld,%d,%.2f,%.4f\n"),
+			Now - StartTime, SimSeconds, NumFrames, NumTasksCreated, NumTasksCancelled, NumAbilityCancels,
+			LiveTasks.Num(), LiveTimers, LiveTaskObjects, UsedPhysicalMB, AvgFrameMs);
+
+		UE_LOG(LogGASDB, Display, TEXT("GASDBSoak: %.0fs  created=%llu  live tasks=%d  task timers=%lld  task objects=%d  memory=%.1f MB  frame=%.3f ms"),
+			Now - StartTime, NumTasksCreated, LiveTasks.Num(), LiveTimers, LiveTaskObjects, UsedPhysicalMB, AvgFrameMs);
+
+		// Warmup samples only seed the trackers; pools and caches are still filling up.
+		const int32 Window = ++NumSamples > WarmupSamples ? GrowthWindow : MAX_int32;
+		auto CheckGrowth = [&FailureReason, Window](FGrowthTracker& Tracker, const double Value)
+		{
+			if (Tracker.AddSample(Value, Window) && FailureReason.IsEmpty())
+			{
+				FailureReason = FString::Printf(TEXT("%s grew in %d consecutive samples (now %.2f)"), Tracker.Name, Tracker.Streak, Value);
+			}
+		};
+		CheckGrowth(Timers, static_cast<double>(LiveTimers));
+		CheckGrowth(TaskObjects, static_cast<double>(LiveTaskObjects));
+		CheckGrowth(Memory, UsedPhysicalMB);
+	}
+
+	// Every task is gone after this, so any timer a task set and never cleared shows up here.
+	for (const TWeakObjectPtr<UAbilityTask>& Task : LiveTasks)
+	{
+		if (Task.IsValid() && !Task->IsFinished())
+		{
+			Task->EndTask();
+		}
+	}
+	LiveTasks.Reset();
+	Harness.TickWorld(FrameDeltaSeconds);
+	DestroySpawnedActors();
+
+	const int64 LeakedTimers = FGASDBTaskMetrics::Get().NumLiveTimers;
+	if (LeakedTimers != 0 && FailureReason.IsEmpty())
+	{
+		FailureReason = FString::Printf(TEXT("%lld task timer(s) still alive after every task ended"), LeakedTimers);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBSoak: could not write %s"), *OutputPath);
+	}
+
+	if (!FailureReason.IsEmpty())
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDBSoak: FAILED after %.0fs: %s. Samples in %s"), FPlatformTime::Seconds() - StartTime, *FailureReason, *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDBSoak: passed. %llu tasks created, %llu cancelled, %llu ability cancels. Samples in %s"),
+		NumTasksCreated, NumTasksCancelled, NumAbilityCancels, *OutputPath);
+	return 0;
+}
+
+void UGASDBSoakCommandlet::CreateTask(FGASDBTaskHarness& Harness)
+{
+	using namespace GASDBSoak;
+
+	UGameplayAbility* OwningAbility = Harness.GetAbility(FMath::RandRange(0, Harness.GetNumAvatars() - 1));
+	if (!OwningAbility)
+	{
+		return;
+	}
+
+	const FVector AvatarLocation = OwningAbility->GetAvatarActorFromActorInfo()->GetActorLocation();
+	const float Lifetime = FMath::FRandRange(0.05f, 2.f);
+
+	UAbilityTask* Task = nullptr;
+	const ETaskType TaskType = static_cast<ETaskType>(NextTaskType);
+	NextTaskType = (NextTaskType + 1) % static_cast<int32>(ETaskType::Num);
+
+	switch (TaskType)
+	{
+	case ETaskType::OnTickEvent:
+		Task = UAbilityTask_OnTickEvent::OnTickEvent(OwningAbility, NAME_None);
+		break;
+
+	case ETaskType::MoveRandomly:
+		Task = UAbilityTask_MoveRandomly::MoveRandomlyTask(OwningAbility, NAME_None, 0.25f, Lifetime);
+		break;
+
+	case ETaskType::MoveInDirection:
+		Task = UAbilityTask_MoveInDirection::MoveInDirectionTask(OwningAbility, NAME_None, FMath::VRand(), 0.015f, Lifetime);
+		break;
+
+	case ETaskType::InstantMove:
+		Task = UAbilityTask_InstantMoveToLocation::InstantMoveToLocation(OwningAbility, AvatarLocation + FMath::VRand() * 20.f, FRotator::ZeroRotator, FMath::RandBool(), false);
+		break;
+
+	case ETaskType::SpawnSafeActor:
+	{
+		UAbilityTask_SpawnSafeActor* SpawnTask = UAbilityTask_SpawnSafeActor::SpawnSafeActor(OwningAbility, NAME_None, AActor::StaticClass(), AvatarLocation + FVector(0.f, 0.f, 300.f), FRotator::ZeroRotator, false);
+		SpawnTask->Success.AddDynamic(this, &UGASDBSoakCommandlet::HandleActorSpawned);
+		Task = SpawnTask;
+		break;
+	}
+
+	case ETaskType::InputLock:
+		// Harness avatars have no PlayerController, so this covers the early-out path.
+		Task = UAbilityTask_InputLock::SetInputLockState(OwningAbility, true, EInputLockType::Timed, Lifetime);
+		break;
+
+	case ETaskType::RunTaskSequence:
+	{
+		TArray<FGASDBTaskStep> Steps;
+		FGASDBTaskStep& MoveStep = Steps.AddDefaulted_GetRef();
+		MoveStep.Type = EGASDBTaskStepType::MoveInDirection;
+		MoveStep.Direction = FMath::VRand();
+		MoveStep.Duration = Lifetime * 0.5f;
+		FGASDBTaskStep& WaitStep = Steps.AddDefaulted_GetRef();
+		WaitStep.Type = EGASDBTaskStepType::WaitTime;
+		WaitStep.Duration = Lifetime * 0.5f;
+		Task = UAbilityTask_RunTaskSequence::RunTaskSequence(OwningAbility, NAME_None, Steps);
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	if (Task)
+	{
+		LiveTasks.Add(Task);
+		Task->ReadyForActivation();
+		++NumTasksCreated;
+	}
+}
+
+void UGASDBSoakCommandlet::CancelRandomTask()
+{
+	// A few dead entries per pick are fine; they are pruned at every sample.
+	for (int32 Attempt = 0; Attempt < 4 && LiveTasks.Num() > 0; ++Attempt)
+	{
+		UAbilityTask* Task = LiveTasks[FMath::RandRange(0, LiveTasks.Num() - 1)].Get();
+		if (Task && !Task->IsFinished())
+		{
+			Task->EndTask();
+			++NumTasksCancelled;
+			return;
+		}
+	}
+}
+
+void UGASDBSoakCommandlet::HandleActorSpawned(AActor* SpawnedActor)
+{
+	SpawnedActors.Add(SpawnedActor);
+}
+
+void UGASDBSoakCommandlet::DestroySpawnedActors()
+{
+	for (const TWeakObjectPtr<AActor>& SpawnedActor : SpawnedActors)
+	{
+		if (AActor* Actor = SpawnedActor.Get())
+		{
+			Actor->Destroy();
+		}
+	}
+	SpawnedActors.Reset();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GASDBSoakCommandlet.generated.h"
+
+class FGASDBTaskHarness;
+class UAbilityTask;
+
+/**
+ * Long-running soak of the GASDB ability tasks, looking for leaked timers, lingering task objects and memory growth.
+ *
+ *   UnrealEditor-Cmd <Project> -run=GASDBSoak -nullrhi -unattended [-Duration=3600] [-Rate=2000] [-Avatars=256]
+ *       [-CancelFraction=0.25] [-AbilityCancels=50] [-SampleInterval=30] [-WarmupSamples=3] [-GrowthWindow=8]
+ *       [-MemoryTolerance=1] [-Output=<path>]
+ *
+ * Every simulated second Rate tasks of every type are created on random avatars; CancelFraction of them are ended
+ * early and AbilityCancels abilities are cancelled mid-task and reactivated. Every SampleInterval wall-clock seconds the
+ * world is garbage collected and the live timer count, live task UObjects and process memory are sampled to a CSV
+ * (by default Saved/Profiling/GASDBSoak.csv). The run fails if any of them grows in GrowthWindow consecutive samples
+ * after the warmup, or if task timers are still alive once every task has ended.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBSoakCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGASDBSoakCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	/** Creates one task of the next type in the rotation on a random avatar */
+	void CreateTask(FGASDBTaskHarness& Harness);
+
+	/** Ends a random live task early */
+	void CancelRandomTask();
+
+	UFUNCTION()
+	void HandleActorSpawned(AActor* SpawnedActor);
+
+	void DestroySpawnedActors();
+
+	TArray<TWeakObjectPtr<UAbilityTask>> LiveTasks;
+
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+
+	int32 NextTaskType = 0;
+
+	uint64 NumTasksCreated = 0;
+
+	uint64 NumTasksCancelled = 0;
+
+	uint64 NumAbilityCancels = 0;
+};
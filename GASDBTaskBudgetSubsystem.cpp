@@ -0,0 +1,276 @@
+#include "GASDBTaskBudgetSubsystem.h"
+#include "Abilities/GameplayAbility.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "Engine/World.h"
+#include "GASDBDebug.h"
+#include "GASDBTaskMetrics.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBTaskBudgetSubsystem)
+
+namespace GASDBTaskBudget
+{
+	static bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("gasdb.Budget.Enable"),
+		bEnabled,
+		TEXT("Measure GASDB task time per category each frame and degrade categories that go over their budget."),
+		ECVF_Default);
+
+	static float PlacementMs = 1.f;
+	static FAutoConsoleVariableRef CVarPlacementMs(
+		TEXT("gasdb.Budget.PlacementMs"),
+		PlacementMs,
+		TEXT("Per-frame game thread budget for SpawnSafeActor and InstantMoveToLocation activations, in milliseconds."),
+		ECVF_Default);
+
+	static float MovementMs = 1.f;
+	static FAutoConsoleVariableRef CVarMovementMs(
+		TEXT("gasdb.Budget.MovementMs"),
+		MovementMs,
+		TEXT("Per-frame game thread budget for MoveRandomly and MoveInDirection updates, in milliseconds."),
+		ECVF_Default);
+
+	static float SimulatedMs = 0.5f;
+	static FAutoConsoleVariableRef CVarSimulatedMs(
+		TEXT("gasdb.Budget.SimulatedMs"),
+		SimulatedMs,
+		TEXT("Per-frame game thread budget for simulated OnTickEvent ticks on clients, in milliseconds."),
+		ECVF_Default);
+
+	static int32 MaxDeferFrames = 4;
+	static FAutoConsoleVariableRef CVarMaxDeferFrames(
+		TEXT("gasdb.Budget.MaxDeferFrames"),
+		MaxDeferFrames,
+		TEXT("Frames an over-budget activation may be deferred before it runs regardless."),
+		ECVF_Default);
+
+	static int32 ThrottleDivisor = 3;
+	static FAutoConsoleVariableRef CVarThrottleDivisor(
+		TEXT("gasdb.Budget.ThrottleDivisor"),
+		ThrottleDivisor,
+		TEXT("While over budget, simulated ticks of a task run on one frame in this many."),
+		ECVF_Default);
+
+	static const TCHAR* GetCategoryName(const EGASDBTaskBudgetCategory Category)
+	{
+		switch (Category)
+		{
+		case EGASDBTaskBudgetCategory::Placement: return TEXT("Placement");
+		case EGASDBTaskBudgetCategory::Movement: return TEXT("Movement");
+		case EGASDBTaskBudgetCategory::Simulated: return TEXT("Simulated");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	static float GetBudgetMs(const EGASDBTaskBudgetCategory Category)
+	{
+		switch (Category)
+		{
+		case EGASDBTaskBudgetCategory::Placement: return PlacementMs;
+		case EGASDBTaskBudgetCategory::Movement: return MovementMs;
+		case EGASDBTaskBudgetCategory::Simulated: return SimulatedMs;
+		default: return 0.f;
+		}
+	}
+}
+
+bool UGASDBTaskBudgetSubsystem::IsEnabled()
+{
+	return GASDBTaskBudget::bEnabled;
+}
+
+UGASDBTaskBudgetSubsystem* UGASDBTaskBudgetSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+	if (!GASDBTaskBudget::bEnabled)
+	{
+		return nullptr;
+	}
+
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UGASDBTaskBudgetSubsystem>() : nullptr;
+}
+
+bool UGASDBTaskBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGASDBTaskBudgetSubsystem::AddTime(const EGASDBTaskBudgetCategory Category, const uint64 Cycles)
+{
+	Categories[static_cast<int32>(Category)].FrameCycles += Cycles;
+}
+
+bool UGASDBTaskBudgetSubsystem::TryDeferActivation(UAbilityTask* Task, const EGASDBTaskBudgetCategory Category, FSimpleDelegate&& ActivateDelegate)
+{
+	if (Task == ReleasingTask || !IsOverBudget(Category))
+	{
+		return false;
+	}
+
+	// The predicting client already ran this activation; holding it back on the server would only cause a correction.
+	const UGameplayAbility* Ability = Task->Ability;
+	if (!Ability || Ability->GetNetExecutionPolicy() == EGameplayAbilityNetExecutionPolicy::LocalPredicted)
+	{
+		return false;
+	}
+
+	DeferredActivations.Add({ Task, Category, MoveTemp(ActivateDelegate), 0 });
+	++Categories[static_cast<int32>(Category)].NumDeferred;
+	++FGASDBTaskMetrics::Get().NumDeferredActivations;
+	INC_DWORD_STAT(STAT_GASDB_DeferredActivations);
+	return true;
+}
+
+bool UGASDBTaskBudgetSubsystem::ShouldSkipUpdate(const UAbilityTask* Task, const EGASDBTaskBudgetCategory Category)
+{
+	const int32 Divisor = FMath::Max(1, GASDBTaskBudget::ThrottleDivisor);
+	if (!IsOverBudget(Category) || (GFrameCounter + Task->GetUniqueID()) % Divisor == 0)
+	{
+		return false;
+	}
+
+	NoteSkippedUpdate(Category);
+	return true;
+}
+
+bool UGASDBTaskBudgetSubsystem::ShouldCollapseUpdate(const UAbilityTask* Task, const EGASDBTaskBudgetCategory Category, uint64& LastUpdateFrame)
+{
+	UGASDBTaskBudgetSubsystem* Budget = GetIfEnabled(Task);
+	if (Budget && Budget->IsOverBudget(Category) && LastUpdateFrame == GFrameCounter)
+	{
+		Budget->NoteSkippedUpdate(Category);
+		return true;
+	}
+
+	LastUpdateFrame = GFrameCounter;
+	return false;
+}
+
+void UGASDBTaskBudgetSubsystem::NoteSkippedUpdate(const EGASDBTaskBudgetCategory Category)
+{
+	++Categories[static_cast<int32>(Category)].NumSkipped;
+	++FGASDBTaskMetrics::Get().NumSkippedUpdates;
+	INC_DWORD_STAT(STAT_GASDB_SkippedUpdates);
+}
+
+void UGASDBTaskBudgetSubsystem::ForgetTask(const UAbilityTask* Task)
+{
+	// Pooled tasks come back for other activations, so an ended task must not keep its queue entry.
+	DeferredActivations.RemoveAll([Task](const FDeferredActivation& Deferred)
+	{
+		return Deferred.Task.Get() == Task;
+	});
+}
+
+void UGASDBTaskBudgetSubsystem::Tick(const float DeltaTime)
+{
+	using namespace GASDBTaskBudget;
+
+	if (!bEnabled)
+	{
+		// Switched off mid-session: nothing may stay queued.
+		if (DeferredActivations.Num() > 0)
+		{
+			ReleaseDeferredActivations();
+		}
+		return;
+	}
+
+	GASDB_SCOPE(Budget_Tick);
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < static_cast<int32>(EGASDBTaskBudgetCategory::Num); ++Index)
+	{
+		const EGASDBTaskBudgetCategory Category = static_cast<EGASDBTaskBudgetCategory>(Index);
+		FCategoryState& State = Categories[Index];
+
+		State.LastFrameMs = FPlatformTime::ToMilliseconds64(State.FrameCycles);
+		State.WorstFrameMs = FMath::Max(State.WorstFrameMs, State.LastFrameMs);
+		State.FrameCycles = 0;
+
+		const float BudgetMs = GetBudgetMs(Category);
+		State.bOverBudget = BudgetMs > 0.f && State.LastFrameMs > BudgetMs;
+		if (!State.bOverBudget)
+		{
+			continue;
+		}
+
+		++State.NumOverruns;
+		++FGASDBTaskMetrics::Get().NumBudgetOverruns;
+		INC_DWORD_STAT(STAT_GASDB_BudgetOverruns);
+
+		if (Now - State.LastLogTime >= 1.0)
+		{
+			State.LastLogTime = Now;
+			GASDB_LOG(this, Warning, TEXT("GASDB budget: %s took %.3f ms of %.3f ms (%llu overruns, %llu deferred, %llu skipped)"),
+				GetCategoryName(Category), State.LastFrameMs, BudgetMs, State.NumOverruns, State.NumDeferred, State.NumSkipped);
+		}
+	}
+
+	ReleaseDeferredActivations();
+}
+
+void UGASDBTaskBudgetSubsystem::ReleaseDeferredActivations()
+{
+	// Taken out first: an activation run from here may defer another task, which then waits for the next frame.
+	TArray<FDeferredActivation> Pending = MoveTemp(DeferredActivations);
+	DeferredActivations.Reset();
+
+	for (FDeferredActivation& Deferred : Pending)
+	{
+		UAbilityTask* Task = Deferred.Task.Get();
+		if (!Task || Task->IsFinished())
+		{
+			continue;
+		}
+
+		if (GASDBTaskBudget::bEnabled && IsOverBudget(Deferred.Category) && ++Deferred.FramesDeferred < GASDBTaskBudget::MaxDeferFrames)
+		{
+			DeferredActivations.Add(MoveTemp(Deferred));
+			continue;
+		}
+
+		ReleasingTask = Task;
+		Deferred.ActivateDelegate.ExecuteIfBound();
+		ReleasingTask = nullptr;
+	}
+}
+
+void UGASDBTaskBudgetSubsystem::Dump(FOutputDevice& Ar) const
+{
+	using namespace GASDBTaskBudget;
+
+	Ar.Logf(TEXT("GASDB task budget (%s), %d activation(s) deferred"), bEnabled ? TEXT("enabled") : TEXT("disabled"), DeferredActivations.Num());
+	Ar.Logf(TEXT("  %-10s %9s %9s %9s %5s %10s %10s %10s"), TEXT("Category"), TEXT("Budget"), TEXT("Last"), TEXT("Worst"), TEXT("Over"), TEXT("Overruns"), TEXT("Deferred"), TEXT("Skipped"));
+	for (int32 Index = 0; Index < static_cast<int32>(EGASDBTaskBudgetCategory::Num); ++Index)
+	{
+		const EGASDBTaskBudgetCategory Category = static_cast<EGASDBTaskBudgetCategory>(Index);
+		const FCategoryState& State = Categories[Index];
+		Ar.Logf(TEXT("  %-10s %9.3f %9.3f %9.3f %5s %10llu %10llu %10llu"), GetCategoryName(Category), GetBudgetMs(Category),
+			State.LastFrameMs, State.WorstFrameMs, State.bOverBudget ? TEXT("yes") : TEXT("no"), State.NumOverruns, State.NumDeferred, State.NumSkipped);
+	}
+}
+
+TStatId UGASDBTaskBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGASDBTaskBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UGASDBTaskBudgetSubsystem::Deinitialize()
+{
+	DeferredActivations.Reset();
+
+	Super::Deinitialize();
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GASDBBudgetDumpCommand(
+	TEXT("gasdb.Budget.Dump"),
+	TEXT("Prints the GASDB task budget per category: budget, last and worst frame time, overruns, deferred activations and skipped updates."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UGASDBTaskBudgetSubsystem* Budget = World ? World->GetSubsystem<UGASDBTaskBudgetSubsystem>() : nullptr)
+		{
+			Budget->Dump(Ar);
+		}
+	}));
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GASDBTaskBudgetSubsystem.generated.h"
+
+class UAbilityTask;
+
+/** Groups of task work that share a per-frame game thread budget */
+enum class EGASDBTaskBudgetCategory : uint8
+{
+	/** SpawnSafeActor and InstantMoveToLocation activations: spawns, overlap tests and sweeps */
+	Placement,
+	/** MoveRandomly and MoveInDirection timer updates */
+	Movement,
+	/** OnTickEvent ticks of simulated copies on clients, which only drive cosmetics */
+	Simulated,
+
+	Num
+};
+
+/**
+ * Measures game thread time spent per task category each frame against gasdb.Budget.<Category>Ms and degrades the
+ * category for the next frame when it went over:
+ *
+ *   - Placement: activations of abilities that are not locally predicted are deferred to a later frame, for at most
+ *     gasdb.Budget.MaxDeferFrames frames. Predicted activations always run, the client has already applied them.
+ *   - Movement: each task updates at most once per frame. Further timer firings in the same frame, two or three per
+ *     frame for MoveRandomly's 0.015 s timer on a 30 Hz server, return after a frame check, outside the measured scope.
+ *     Character movement consumes input once per frame and clamps it to unit length, so the distance covered does not
+ *     change.
+ *   - Simulated: each task ticks on one frame in gasdb.Budget.ThrottleDivisor, staggered across tasks; the skipped
+ *     time is handed to the next tick that runs.
+ *
+ * Off unless gasdb.Budget.Enable is set, in which case each measured scope costs two cycle counter reads. Overruns,
+ * deferrals and skips are counted in FGASDBTaskMetrics and `stat GASDB`, logged at most once per second per category,
+ * and gasdb.Budget.Dump prints the per-category state.
+ */
+UCLASS()
+class LYRAGAME_API UGASDBTaskBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsEnabled();
+
+	/** The world's subsystem if the governor is on */
+	static UGASDBTaskBudgetSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+	void AddTime(EGASDBTaskBudgetCategory Category, uint64 Cycles);
+
+	/** Whether the category went over its budget in the last measured frame */
+	bool IsOverBudget(const EGASDBTaskBudgetCategory Category) const { return Categories[static_cast<int32>(Category)].bOverBudget; }
+
+	/**
+	 * Queues the task's activation for a later frame if its category is over budget and the activation may wait. The
+	 * task returns from Activate when this returns true; the subsystem runs ActivateDelegate once there is room.
+	 */
+	bool TryDeferActivation(UAbilityTask* Task, EGASDBTaskBudgetCategory Category, FSimpleDelegate&& ActivateDelegate);
+
+	/** True if an over-budget category should skip this update of Task this frame */
+	bool ShouldSkipUpdate(const UAbilityTask* Task, EGASDBTaskBudgetCategory Category);
+
+	/**
+	 * True if the category is over budget and Task already updated this frame, so this update should be dropped.
+	 * Otherwise stamps LastUpdateFrame with the current frame. Call it before the budget scope. False when the governor
+	 * is off.
+	 */
+	static bool ShouldCollapseUpdate(const UAbilityTask* Task, EGASDBTaskBudgetCategory Category, uint64& LastUpdateFrame);
+
+	/** Drops a deferred activation of a task that ended before it ran. Called by the task pool. */
+	void ForgetTask(const UAbilityTask* Task);
+
+	void Dump(FOutputDevice& Ar) const;
+
+	//~ Begin UTickableWorldSubsystem Interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End UTickableWorldSubsystem Interface
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCategoryState
+	{
+		uint64 FrameCycles = 0;
+		double LastFrameMs = 0.0;
+		double WorstFrameMs = 0.0;
+		bool bOverBudget = false;
+		uint64 NumOverruns = 0;
+		uint64 NumDeferred = 0;
+		uint64 NumSkipped = 0;
+		double LastLogTime = 0.0;
+	};
+
+	struct FDeferredActivation
+	{
+		TWeakObjectPtr<UAbilityTask> Task;
+		EGASDBTaskBudgetCategory Category = EGASDBTaskBudgetCategory::Placement;
+		FSimpleDelegate ActivateDelegate;
+		int32 FramesDeferred = 0;
+	};
+
+	void NoteSkippedUpdate(EGASDBTaskBudgetCategory Category);
+
+	/** Activates deferred tasks whose category has room again or that waited long enough */
+	void ReleaseDeferredActivations();
+
+	TStaticArray<FCategoryState, static_cast<int32>(EGASDBTaskBudgetCategory::Num)> Categories;
+
+	TArray<FDeferredActivation> DeferredActivations;
+
+	/** The task whose deferred activation is running, so its Activate does not defer it again */
+	const UAbilityTask* ReleasingTask = nullptr;
+};
+
+/** Adds the time until the end of the scope to a budget category of the world of WorldContextObject; a null context measures nothing */
+class FGASDBTaskBudgetScope
+{
+public:
+	FGASDBTaskBudgetScope(const UObject* WorldContextObject, const EGASDBTaskBudgetCategory InCategory)
+		: Budget(UGASDBTaskBudgetSubsystem::GetIfEnabled(WorldContextObject))
+		, Category(InCategory)
+		, StartCycles(Budget ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FGASDBTaskBudgetScope()
+	{
+		if (Budget)
+		{
+			Budget->AddTime(Category, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+	UE_NONCOPYABLE(FGASDBTaskBudgetScope);
+
+	/** See UGASDBTaskBudgetSubsystem::ShouldSkipUpdate. False when the governor is off. */
+	bool ShouldSkipUpdate(const UAbilityTask* Task) const
+	{
+		return Budget && Budget->ShouldSkipUpdate(Task, Category);
+	}
+
+private:
+	UGASDBTaskBudgetSubsystem* Budget;
+	EGASDBTaskBudgetCategory Category;
+	uint64 StartCycles;
+};
+
+/** Measures the rest of the enclosing member function of a task against a category, e.g. GASDB_BUDGET_SCOPE(Movement) */
+#define GASDB_BUDGET_SCOPE(Category) \
+	FGASDBTaskBudgetScope PREPROCESSOR_JOIN(GASDBBudgetScope_, __LINE__)(this, EGASDBTaskBudgetCategory::Category)
@@ -0,0 +1,227 @@
+#include "GASDBTaskHarness.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBDebug.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "UObject/Package.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GASDBTaskHarness)
+
+namespace GASDBTaskHarness
+{
+	static constexpr float AvatarSpacing = 200.f;
+}
+
+AGASDBHarnessAvatar::AGASDBHarnessAvatar(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	AutoPossessAI = EAutoPossessAI::Disabled;
+
+	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+
+	// No level geometry and no controller: fly, and keep consuming movement input anyway.
+	UCharacterMovementComponent* MovementComponent = GetCharacterMovement();
+	MovementComponent->DefaultLandMovementMode = MOVE_Flying;
+	MovementComponent->bRunPhysicsWithNoController = true;
+}
+
+UGASDBHarnessAbility::UGASDBHarnessAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalOnly;
+}
+
+FGASDBTaskHarness::~FGASDBTaskHarness()
+{
+	Shutdown();
+}
+
+bool FGASDBTaskHarness::Initialize(const FString& MapPackageName)
+{
+	check(GEngine);
+
+	if (MapPackageName.IsEmpty())
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("GASDBTaskHarness"));
+		if (!World)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+		World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+		if (!World)
+		{
+			UE_LOG(LogGASDB, Error, TEXT("FGASDBTaskHarness: could not load map %s"), *MapPackageName);
+			return false;
+		}
+
+		// DestroyWorld removes it from the root set again in Shutdown.
+		World->WorldType = EWorldType::Game;
+		World->AddToRoot();
+		World->InitWorld();
+		World->UpdateWorldComponents(true, false);
+	}
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	return true;
+}
+
+void FGASDBTaskHarness::SpawnAvatars(const int32 NumAvatars)
+{
+	check(World);
+
+	const int32 GridSize = FMath::Max(1, FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(NumAvatars))));
+	for (int32 Index = Avatars.Num(); Index < NumAvatars; ++Index)
+	{
+		const FVector Location((Index % GridSize) * GASDBTaskHarness::AvatarSpacing, (Index / GridSize) * GASDBTaskHarness::AvatarSpacing, 0.f);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AGASDBHarnessAvatar* Avatar = World->SpawnActor<AGASDBHarnessAvatar>(Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Avatar)
+		{
+			UE_LOG(LogGASDB, Error, TEXT("FGASDBTaskHarness: failed to spawn avatar %d"), Index);
+			return;
+		}
+
+		UAbilitySystemComponent* ASC = Avatar->GetAbilitySystemComponent();
+		ASC->InitAbilityActorInfo(Avatar, Avatar);
+
+		const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(FGameplayAbilitySpec(UGASDBHarnessAbility::StaticClass()));
+		ASC->TryActivateAbility(Handle);
+
+		const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(Handle);
+		UGameplayAbility* Ability = Spec ? Spec->GetPrimaryInstance() : nullptr;
+		if (!Ability || !Ability->IsActive())
+		{
+			UE_LOG(LogGASDB, Error, TEXT("FGASDBTaskHarness: failed to activate the harness ability on avatar %d"), Index);
+			Avatar->Destroy();
+			return;
+		}
+
+		Avatars.Add(Avatar);
+		Abilities.Add(Ability);
+		AbilityHandles.Add(Handle);
+	}
+}
+
+void FGASDBTaskHarness::TrackTask(UAbilityTask* Task)
+{
+	if (Task)
+	{
+		TrackedTasks.Add(Task);
+	}
+}
+
+void FGASDBTaskHarness::PruneTrackedTasks()
+{
+	TrackedTasks.RemoveAllSwap([](const TWeakObjectPtr<UAbilityTask>& Task)
+	{
+		return !Task.IsValid() || Task->IsFinished();
+	}, EAllowShrinking::No);
+}
+
+bool FGASDBTaskHarness::CancelAndReactivateAbility(const int32 Index)
+{
+	AGASDBHarnessAvatar* Avatar = Avatars[Index].Get();
+	if (!Avatar)
+	{
+		return false;
+	}
+
+	UAbilitySystemComponent* ASC = Avatar->GetAbilitySystemComponent();
+	ASC->CancelAbilityHandle(AbilityHandles[Index]);
+	if (!ASC->TryActivateAbility(AbilityHandles[Index]))
+	{
+		return false;
+	}
+
+	const FGameplayAbilitySpec* Spec = ASC->FindAbilitySpecFromHandle(AbilityHandles[Index]);
+	Abilities[Index] = Spec ? Spec->GetPrimaryInstance() : nullptr;
+	return Abilities[Index].IsValid();
+}
+
+void FGASDBTaskHarness::EndAllTasks()
+{
+	for (const TWeakObjectPtr<UAbilityTask>& Task : TrackedTasks)
+	{
+		if (Task.IsValid() && !Task->IsFinished())
+		{
+			Task->EndTask();
+		}
+	}
+	TrackedTasks.Reset();
+
+	if (World)
+	{
+		TickWorld(0.f);
+	}
+}
+
+int32 FGASDBTaskHarness::GetNumLiveTrackedTasks() const
+{
+	int32 NumLive = 0;
+	for (const TWeakObjectPtr<UAbilityTask>& Task : TrackedTasks)
+	{
+		if (Task.IsValid() && !Task->IsFinished())
+		{
+			++NumLive;
+		}
+	}
+	return NumLive;
+}
+
+double FGASDBTaskHarness::TickWorld(const float DeltaSeconds)
+{
+	check(World);
+
+	FApp::SetDeltaTime(DeltaSeconds);
+	FApp::SetCurrentTime(FApp::GetCurrentTime() + DeltaSeconds);
+
+	const double StartTime = FPlatformTime::Seconds();
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+	const double TickSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// The engine loop is not running, so recycle this frame's released tasks here instead of on FCoreDelegates::OnEndFrame.
+	if (UGASDBAbilityTaskPool* Pool = UGASDBAbilityTaskPool::Get())
+	{
+		Pool->ReleasePendingTasks();
+	}
+
+	++GFrameCounter;
+	return TickSeconds;
+}
+
+void FGASDBTaskHarness::Shutdown()
+{
+	if (!World)
+	{
+		return;
+	}
+
+	TrackedTasks.Reset();
+	AbilityHandles.Reset();
+	Abilities.Reset();
+	Avatars.Reset();
+
+	World->EndPlay(EEndPlayReason::Quit);
+	if (GEngine)
+	{
+		GEngine->DestroyWorldContext(World);
+	}
+	World->DestroyWorld(false);
+	World = nullptr;
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemInterface.h"
+#include "Abilities/GameplayAbility.h"
+#include "GameFramework/Character.h"
+#include "GASDBTaskHarness.generated.h"
+
+class UAbilitySystemComponent;
+
+/** Bare character with its own ability system component, spawned by FGASDBTaskHarness. */
+UCLASS(NotBlueprintable, Transient)
+class LYRAGAME_API AGASDBHarnessAvatar : public ACharacter, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+
+public:
+	AGASDBHarnessAvatar(const FObjectInitializer& ObjectInitializer);
+
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override { return AbilitySystemComponent; }
+
+private:
+	UPROPERTY()
+	TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+};
+
+/** Ability that does nothing on its own; the harness creates tasks on its active instance. */
+UCLASS(NotBlueprintable, Transient)
+class LYRAGAME_API UGASDBHarnessAbility : public UGameplayAbility
+{
+	GENERATED_BODY()
+
+public:
+	UGASDBHarnessAbility();
+};
+
+/**
+ * Headless world with N avatars, each with an active UGASDBHarnessAbility, used by the GASDB commandlets to drive the
+ * ability tasks without a map, a player or a renderer (run with -nullrhi).
+ */
+class LYRAGAME_API FGASDBTaskHarness
+{
+public:
+	~FGASDBTaskHarness();
+
+	/**
+	 * Creates an empty world, or loads MapPackageName (e.g. /Game/Maps/Arena) so scene queries hit real geometry, and
+	 * begins play. Returns false if the world could not be created or the map could not be loaded.
+	 */
+	bool Initialize(const FString& MapPackageName = FString());
+
+	/** Spawns avatars until there are NumAvatars, laid out on a grid so they do not overlap. */
+	void SpawnAvatars(int32 NumAvatars);
+
+	/** Ends every task created through TrackTask and runs one frame so their OnDestroy completes. */
+	void EndAllTasks();
+
+	/** Remembers a task so EndAllTasks can end it */
+	void TrackTask(UAbilityTask* Task);
+
+	/** Forgets tracked tasks that have already ended */
+	void PruneTrackedTasks();
+
+	/** Cancels the avatar's ability, ending every task it owns, and activates it again. Returns false if it did not reactivate. */
+	bool CancelAndReactivateAbility(int32 Index);
+
+	/** Ticks the world once. Returns the wall time the tick took, in seconds. */
+	double TickWorld(float DeltaSeconds);
+
+	/** Destroys the world. Called by the destructor if needed. */
+	void Shutdown();
+
+	UWorld* GetWorld() const { return World; }
+
+	int32 GetNumAvatars() const { return Avatars.Num(); }
+
+	AGASDBHarnessAvatar* GetAvatar(int32 Index) const { return Avatars[Index].Get(); }
+
+	/** The active ability instance of an avatar, to pass as OwningAbility to task factories */
+	UGameplayAbility* GetAbility(int32 Index) const { return Abilities[Index].Get(); }
+
+	int32 GetNumLiveTrackedTasks() const;
+
+private:
+	UWorld* World = nullptr;
+
+	TArray<TWeakObjectPtr<AGASDBHarnessAvatar>> Avatars;
+
+	TArray<TWeakObjectPtr<UGameplayAbility>> Abilities;
+
+	TArray<FGameplayAbilitySpecHandle> AbilityHandles;
+
+	TArray<TWeakObjectPtr<UAbilityTask>> TrackedTasks;
+};
@@ -0,0 +1,101 @@
+#include "GASDBTaskMetrics.h"
+#include "Abilities/GameplayAbility.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_STAT(STAT_GASDB_ActiveTasks);
+DEFINE_STAT(STAT_GASDB_LiveTimers);
+DEFINE_STAT(STAT_GASDB_SceneQueries);
+DEFINE_STAT(STAT_GASDB_BudgetOverruns);
+DEFINE_STAT(STAT_GASDB_DeferredActivations);
+DEFINE_STAT(STAT_GASDB_SkippedUpdates);
+
+UE_TRACE_CHANNEL_DEFINE(GASDBChannel);
+
+FGASDBTaskMetrics& FGASDBTaskMetrics::Get()
+{
+	static FGASDBTaskMetrics Instance;
+	return Instance;
+}
+
+void FGASDBTaskMetrics::NoteTimerSet(const FTimerHandle& Handle)
+{
+	if (Handle.IsValid())
+	{
+		++Get().NumLiveTimers;
+		INC_DWORD_STAT(STAT_GASDB_LiveTimers);
+	}
+}
+
+void FGASDBTaskMetrics::ClearTimer(FTimerManager& TimerManager, FTimerHandle& Handle)
+{
+	if (TimerManager.TimerExists(Handle))
+	{
+		--Get().NumLiveTimers;
+		DEC_DWORD_STAT(STAT_GASDB_LiveTimers);
+	}
+	TimerManager.ClearTimer(Handle);
+}
+
+void FGASDBTaskMetrics::NoteTaskCreated(const UAbilityTask* Task)
+{
+	++ActiveTasksByClass.FindOrAdd(Task->GetClass());
+	INC_DWORD_STAT(STAT_GASDB_ActiveTasks);
+}
+
+void FGASDBTaskMetrics::NoteTaskEnded(const UAbilityTask* Task)
+{
+	// Simulated copies of replicated tasks are created by replication, never by a factory, so they were not counted.
+	if (Task->IsSimulating())
+	{
+		return;
+	}
+
+	if (int32* NumActive = ActiveTasksByClass.Find(Task->GetClass()); NumActive && *NumActive > 0)
+	{
+		--*NumActive;
+		DEC_DWORD_STAT(STAT_GASDB_ActiveTasks);
+	}
+}
+
+void FGASDBTaskMetrics::DumpTasks(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("GASDB active tasks by class:"));
+	for (const TPair<const UClass*, int32>& Pair : ActiveTasksByClass)
+	{
+		Ar.Logf(TEXT("  %-40s %d"), *GetNameSafe(Pair.Key), Pair.Value);
+	}
+	Ar.Logf(TEXT("  live task timers: %lld, scene queries since start: %llu"), NumLiveTimers, NumSceneQueries);
+	Ar.Logf(TEXT("  budget overruns: %llu, deferred activations: %llu, skipped updates: %llu"), NumBudgetOverruns, NumDeferredActivations, NumSkippedUpdates);
+
+	// Walk the object array instead of keeping a per-task registry so creating a task stays a single map update.
+	TMap<const UGameplayAbility*, TMap<const UClass*, int32>> TasksByAbility;
+	for (TObjectIterator<UAbilityTask> It; It; ++It)
+	{
+		const UAbilityTask* Task = *It;
+		if (IsValid(Task) && !Task->IsFinished() && Task->Ability)
+		{
+			++TasksByAbility.FindOrAdd(Task->Ability).FindOrAdd(Task->GetClass());
+		}
+	}
+
+	Ar.Logf(TEXT("GASDB running tasks by ability (%d abilities):"), TasksByAbility.Num());
+	for (const TPair<const UGameplayAbility*, TMap<const UClass*, int32>>& AbilityPair : TasksByAbility)
+	{
+		Ar.Logf(TEXT("  %s (%s)"), *GetNameSafe(AbilityPair.Key), *GetNameSafe(AbilityPair.Key->GetAvatarActorFromActorInfo()));
+		for (const TPair<const UClass*, int32>& TaskPair : AbilityPair.Value)
+		{
+			Ar.Logf(TEXT("    %-38s %d"), *GetNameSafe(TaskPair.Key), TaskPair.Value);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice GASDBTasksDumpCommand(
+	TEXT("gasdb.Tasks.Dump"),
+	TEXT("Prints active GASDB task counts per class and the running ability tasks grouped by owning ability."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+	{
+		FGASDBTaskMetrics::Get().DumpTasks(Ar);
+	}));
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+class FTimerManager;
+class UAbilityTask;
+struct FTimerHandle;
+
+DECLARE_STATS_GROUP(TEXT("GASDB"), STATGROUP_GASDB, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Tasks"), STAT_GASDB_ActiveTasks, STATGROUP_GASDB, LYRAGAME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Task Timers"), STAT_GASDB_LiveTimers, STATGROUP_GASDB, LYRAGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Queries"), STAT_GASDB_SceneQueries, STATGROUP_GASDB, LYRAGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Budget Overruns"), STAT_GASDB_BudgetOverruns, STATGROUP_GASDB, LYRAGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Activations"), STAT_GASDB_DeferredActivations, STATGROUP_GASDB, LYRAGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Skipped Updates"), STAT_GASDB_SkippedUpdates, STATGROUP_GASDB, LYRAGAME_API);
+
+/** Insights channel for the GASDB task scopes: -trace=cpu,GASDB */
+UE_TRACE_CHANNEL_EXTERN(GASDBChannel, LYRAGAME_API);
+
+/**
+ * Process-wide counters for work done by the GASDB tasks, read by the benchmark and soak commandlets, `stat GASDB` and
+ * gasdb.Tasks.Dump. Game thread only; updating a counter is a plain add so they stay on in every build configuration.
+ */
+struct LYRAGAME_API FGASDBTaskMetrics
+{
+	static FGASDBTaskMetrics& Get();
+
+	/** Counts a timer a task just set, if the timer manager actually created one */
+	static void NoteTimerSet(const FTimerHandle& Handle);
+
+	/** Clears a task's timer and stops counting it. Safe to call with an invalid or already expired handle. */
+	static void ClearTimer(FTimerManager& TimerManager, FTimerHandle& Handle);
+
+	/** Called by the task pool for every task a GASDB factory creates, and for every task it sees end. Simulated tasks are ignored. */
+	void NoteTaskCreated(const UAbilityTask* Task);
+	void NoteTaskEnded(const UAbilityTask* Task);
+
+	/** Prints active task counts per class, then the running tasks grouped by owning ability */
+	void DumpTasks(FOutputDevice& Ar) const;
+
+	/** Overlap tests, sweeps and per-body MTD queries issued by the tasks */
+	uint64 NumSceneQueries = 0;
+
+	/** Timers set by the tasks that have not been cleared yet */
+	int64 NumLiveTimers = 0;
+
+	/** Frames in which a UGASDBTaskBudgetSubsystem category went over budget, and what the governor did about it */
+	uint64 NumBudgetOverruns = 0;
+	uint64 NumDeferredActivations = 0;
+	uint64 NumSkippedUpdates = 0;
+
+	/** GASDB tasks created and not ended yet, per task class */
+	TMap<const UClass*, int32> ActiveTasksByClass;
+};
+
+/** Cycle stat in STATGROUP_GASDB plus an Insights CPU scope on GASDBChannel, e.g. GASDB_SCOPE(SpawnSafeActor_Activate) */
+#define GASDB_SCOPE(ScopeName) \
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#ScopeName), STAT_GASDB_##ScopeName, STATGROUP_GASDB); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(GASDB_##ScopeName, GASDBChannel)
+
+#define GASDB_COUNT_SCENE_QUERY() \
+	do { ++FGASDBTaskMetrics::Get().NumSceneQueries; INC_DWORD_STAT(STAT_GASDB_SceneQueries); } while (0)
@@ -0,0 +1,706 @@
+#include "GASDBTaskRecording.h"
+#include "AbilityTask_InputLock.h"
+#include "AbilityTask_InstantMoveToLocation.h"
+#include "AbilityTask_MoveInDirection.h"
+#include "AbilityTask_MoveRandomly.h"
+#include "AbilityTask_OnTickEvent.h"
+#include "AbilityTask_SpawnSafeActor.h"
+#include "AbilityTask_WaitEnhancedInputEvent.h"
+#include "Engine/World.h"
+#include "GASDBDebug.h"
+#include "GASDBTaskHarness.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "InputAction.h"
+#include "Misc/Paths.h"
+
+namespace GASDBRecording
+{
+	enum EStepFlags : uint8
+	{
+		StepSweep = 1 << 0,
+		StepStopAtCollision = 1 << 1,
+		StepSetRotation = 1 << 2,
+		StepMoveEncroachingActors = 1 << 3
+	};
+
+	template <typename TEnum>
+	static void SerializeEnum(FArchive& Ar, TEnum& Value)
+	{
+		uint8 Byte = static_cast<uint8>(Value);
+		Ar << Byte;
+		Value = static_cast<TEnum>(Byte);
+	}
+
+	static void SerializeVector(FArchive& Ar, FVector& Value)
+	{
+		FVector3f Compact(Value);
+		Ar << Compact;
+		Value = FVector(Compact);
+	}
+
+	static void SerializeRotator(FArchive& Ar, FRotator& Value)
+	{
+		FRotator3f Compact(Value);
+		Ar << Compact;
+		Value = FRotator(Compact);
+	}
+
+	static void SerializeStep(FArchive& Ar, FGASDBRecordedEvent::FStep& RecordedStep)
+	{
+		FGASDBTaskStep& Step = RecordedStep.Step;
+		SerializeEnum(Ar, Step.Type);
+		Ar << Step.Duration;
+
+		uint8 LockChannels = static_cast<uint8>(Step.LockChannels);
+		Ar << LockChannels;
+		Step.LockChannels = LockChannels;
+
+		SerializeVector(Ar, Step.Direction);
+		Ar << Step.Interval;
+		SerializeVector(Ar, Step.Location);
+		SerializeRotator(Ar, Step.Rotation);
+
+		uint8 StepFlags = (Step.bSweep ? StepSweep : 0) | (Step.bStopAtCollision ? StepStopAtCollision : 0)
+			| (Step.bSetRotation ? StepSetRotation : 0) | (Step.bMoveEncroachingActors ? StepMoveEncroachingActors : 0);
+		Ar << StepFlags;
+		Step.bSweep = (StepFlags & StepSweep) != 0;
+		Step.bStopAtCollision = (StepFlags & StepStopAtCollision) != 0;
+		Step.bSetRotation = (StepFlags & StepSetRotation) != 0;
+		Step.bMoveEncroachingActors = (StepFlags & StepMoveEncroachingActors) != 0;
+
+		Ar.SerializeIntPacked(RecordedStep.ActorClassIndex);
+		Ar.SerializeIntPacked(RecordedStep.InputActionIndex);
+		SerializeEnum(Ar, Step.TriggerEvent);
+		Ar << Step.LookbackWindow;
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FGASDBRecordedEvent& Event)
+{
+	using namespace GASDBRecording;
+
+	SerializeEnum(Ar, Event.Type);
+	Ar.SerializeIntPacked(Event.DeltaMicros);
+
+	switch (Event.Type)
+	{
+	case EGASDBRecordedEventType::DefineObject:
+		Ar.SerializeIntPacked(Event.Index);
+		Ar << Event.ObjectPath;
+		break;
+
+	case EGASDBRecordedEventType::DefineAvatar:
+		Ar.SerializeIntPacked(Event.Index);
+		Ar << Event.Vector;
+		break;
+
+	case EGASDBRecordedEventType::TaskCreated:
+		Ar.SerializeIntPacked(Event.TaskId);
+		Ar.SerializeIntPacked(Event.AvatarIndex);
+		SerializeEnum(Ar, Event.TaskType);
+
+		switch (Event.TaskType)
+		{
+		case EGASDBRecordedTask::MoveRandomly:
+			Ar << Event.Floats[0] << Event.Floats[1];
+			break;
+
+		case EGASDBRecordedTask::MoveInDirection:
+			Ar << Event.Vector << Event.Floats[0] << Event.Floats[1];
+			break;
+
+		case EGASDBRecordedTask::InstantMoveToLocation:
+			Ar << Event.Vector << Event.Rotator << Event.Flags;
+			break;
+
+		case EGASDBRecordedTask::SpawnSafeActor:
+			Ar.SerializeIntPacked(Event.Index);
+			Ar << Event.Vector << Event.Rotator << Event.Flags;
+			break;
+
+		case EGASDBRecordedTask::InputLock:
+			Ar << Event.Flags << Event.Enum << Event.Floats[0];
+			break;
+
+		case EGASDBRecordedTask::WaitEnhancedInputEvent:
+			Ar.SerializeIntPacked(Event.Index);
+			Ar << Event.Enum << Event.Flags << Event.Floats[0];
+			break;
+
+		case EGASDBRecordedTask::RunTaskSequence:
+		{
+			Ar << Event.Enum;
+			uint32 NumSteps = Event.Steps.Num();
+			Ar.SerializeIntPacked(NumSteps);
+			if (Ar.IsLoading())
+			{
+				Event.Steps.SetNum(NumSteps);
+			}
+			for (FGASDBRecordedEvent::FStep& Step : Event.Steps)
+			{
+				SerializeStep(Ar, Step);
+			}
+			break;
+		}
+
+		default:
+			break;
+		}
+		break;
+
+	case EGASDBRecordedEventType::TaskEnded:
+		Ar.SerializeIntPacked(Event.TaskId);
+		break;
+
+	case EGASDBRecordedEventType::InputValue:
+		Ar.SerializeIntPacked(Event.TaskId);
+		Ar << Event.Enum << Event.Vector;
+		break;
+
+	default:
+		break;
+	}
+
+	return Ar;
+}
+
+bool FGASDBTaskRecorder::bRecording = false;
+
+FGASDBTaskRecorder& FGASDBTaskRecorder::Get()
+{
+	static FGASDBTaskRecorder Instance;
+	return Instance;
+}
+
+bool FGASDBTaskRecorder::Start(const FString& FilePath, const EGASDBRecordWorld InWorldFilter)
+{
+	Stop();
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter)
+	{
+		UE_LOG(LogGASDB, Error, TEXT("GASDB task recorder: could not open %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = FileMagic;
+	uint16 Version = FileVersion;
+	*FileWriter << Magic << Version;
+
+	LastEventTime = FPlatformTime::Seconds();
+	NextTaskId = 1;
+	WorldFilter = InWorldFilter;
+	RecordedWorld = nullptr;
+	bRecording = true;
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDB task recorder: recording to %s"), *FilePath);
+	return true;
+}
+
+void FGASDBTaskRecorder::Stop()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FGASDBRecordedEvent EndOfStream;
+	Write(EndOfStream);
+
+	UE_LOG(LogGASDB, Display, TEXT("GASDB task recorder: stopped after %u tasks, %lld bytes"), NextTaskId - 1, FileWriter->Tell());
+
+	FileWriter->Close();
+	FileWriter.Reset();
+	TaskIds.Reset();
+	AvatarIndices.Reset();
+	ObjectIndices.Reset();
+	RecordedWorld = nullptr;
+	bRecording = false;
+}
+
+void FGASDBTaskRecorder::Write(FGASDBRecordedEvent& Event)
+{
+	// Advance by the rounded delta so rounding errors do not pile up over a long session.
+	const double Now = FPlatformTime::Seconds();
+	Event.DeltaMicros = static_cast<uint32>(FMath::Clamp((Now - LastEventTime) * 1.0e6, 0.0, static_cast<double>(MAX_uint32)));
+	LastEventTime += Event.DeltaMicros / 1.0e6;
+
+	*FileWriter << Event;
+}
+
+uint32 FGASDBTaskRecorder::GetObjectIndex(const UObject* Object)
+{
+	if (!Object)
+	{
+		return 0;
+	}
+
+	if (const uint32* Index = ObjectIndices.Find(Object))
+	{
+		return *Index;
+	}
+
+	FGASDBRecordedEvent Define;
+	Define.Type = EGASDBRecordedEventType::DefineObject;
+	Define.Index = ObjectIndices.Num() + 1;
+	Define.ObjectPath = Object->GetPathName();
+	Write(Define);
+
+	ObjectIndices.Add(Object, Define.Index);
+	return Define.Index;
+}
+
+bool FGASDBTaskRecorder::ShouldRecordWorld(const UWorld* World)
+{
+	if (WorldFilter == EGASDBRecordWorld::Any)
+	{
+		return true;
+	}
+
+	if (RecordedWorld.IsValid())
+	{
+		return World == RecordedWorld.Get();
+	}
+
+	const bool bIsClient = World && World->GetNetMode() == NM_Client;
+	if (!World || bIsClient != (WorldFilter == EGASDBRecordWorld::Client))
+	{
+		return false;
+	}
+
+	RecordedWorld = World;
+	return true;
+}
+
+bool FGASDBTaskRecorder::BeginTaskCreated(const UAbilityTask* Task, const EGASDBRecordedTask TaskType, FGASDBRecordedEvent& OutEvent)
+{
+	const AActor* Avatar = Task ? Task->GetAvatarActor() : nullptr;
+	if (!Avatar || !ShouldRecordWorld(Avatar->GetWorld()))
+	{
+		return false;
+	}
+
+	uint32 AvatarIndex = 0;
+	if (const uint32* ExistingIndex = AvatarIndices.Find(Avatar))
+	{
+		AvatarIndex = *ExistingIndex;
+	}
+	else
+	{
+		FGASDBRecordedEvent Define;
+		Define.Type = EGASDBRecordedEventType::DefineAvatar;
+		Define.Index = AvatarIndex = AvatarIndices.Num() + 1;
+		Define.Vector = FVector3f(Avatar->GetActorLocation());
+		Write(Define);
+
+		AvatarIndices.Add(Avatar, AvatarIndex);
+	}
+
+	OutEvent.Type = EGASDBRecordedEventType::TaskCreated;
+	OutEvent.TaskId = NextTaskId++;
+	OutEvent.AvatarIndex = AvatarIndex;
+	OutEvent.TaskType = TaskType;
+
+	// A pooled task object can come back for a later activation; the newest id wins.
+	TaskIds.Add(Task, OutEvent.TaskId);
+	return true;
+}
+
+void FGASDBTaskRecorder::RecordOnTickEvent(const UAbilityTask* Task)
+{
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::OnTickEvent, Event))
+	{
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordMoveRandomly(const UAbilityTask* Task, const float DirectionChangeInterval, const float TotalDuration)
+{
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::MoveRandomly, Event))
+	{
+		Event.Floats[0] = DirectionChangeInterval;
+		Event.Floats[1] = TotalDuration;
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordMoveInDirection(const UAbilityTask* Task, const FVector& Direction, const float Interval, const float Duration)
+{
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::MoveInDirection, Event))
+	{
+		Event.Vector = FVector3f(Direction);
+		Event.Floats[0] = Interval;
+		Event.Floats[1] = Duration;
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordInstantMove(const UAbilityTask* Task, const FVector& TargetLocation, const FRotator& TargetRotation, const bool bSweep, const bool bStopAtCollision, const bool bSetRotation)
+{
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::InstantMoveToLocation, Event))
+	{
+		Event.Vector = FVector3f(TargetLocation);
+		Event.Rotator = FRotator3f(TargetRotation);
+		Event.Flags = (bSweep ? 1 : 0) | (bStopAtCollision ? 2 : 0) | (bSetRotation ? 4 : 0);
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordSpawnSafeActor(const UAbilityTask* Task, const UClass* ActorClass, const FVector& Location, const FRotator& Rotation, const bool bMoveEncroachingActors)
+{
+	const uint32 ClassIndex = GetObjectIndex(ActorClass);
+
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::SpawnSafeActor, Event))
+	{
+		Event.Index = ClassIndex;
+		Event.Vector = FVector3f(Location);
+		Event.Rotator = FRotator3f(Rotation);
+		Event.Flags = bMoveEncroachingActors ? 1 : 0;
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordInputLock(const UAbilityTask* Task, const bool bShouldLock, const uint8 LockType, const float Duration, const bool bLockMove, const bool bLockLook)
+{
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::InputLock, Event))
+	{
+		Event.Flags = (bShouldLock ? 1 : 0) | (bLockMove ? 2 : 0) | (bLockLook ? 4 : 0);
+		Event.Enum = LockType;
+		Event.Floats[0] = Duration;
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordWaitEnhancedInputEvent(const UAbilityTask* Task, const UInputAction* InputAction, const ETriggerEvent TriggerEvent, const EGASDBRecordedInputMode Mode, const float Window, const bool bShouldOnlyTriggerOnce)
+{
+	const uint32 ActionIndex = GetObjectIndex(InputAction);
+
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::WaitEnhancedInputEvent, Event))
+	{
+		Event.Index = ActionIndex;
+		Event.Enum = static_cast<uint8>(TriggerEvent);
+		Event.Flags = (static_cast<uint8>(Mode) << 1) | (bShouldOnlyTriggerOnce ? 1 : 0);
+		Event.Floats[0] = Window;
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordTaskSequence(const UAbilityTask* Task, const TConstArrayView<FGASDBTaskStep> Steps, const EGASDBTaskSequenceMode Mode)
+{
+	TArray<FGASDBRecordedEvent::FStep, TInlineAllocator<4>> RecordedSteps;
+	for (const FGASDBTaskStep& Step : Steps)
+	{
+		FGASDBRecordedEvent::FStep& RecordedStep = RecordedSteps.AddDefaulted_GetRef();
+		RecordedStep.Step = Step;
+		RecordedStep.ActorClassIndex = GetObjectIndex(Step.ActorClass.Get());
+		RecordedStep.InputActionIndex = GetObjectIndex(Step.InputAction);
+	}
+
+	FGASDBRecordedEvent Event;
+	if (BeginTaskCreated(Task, EGASDBRecordedTask::RunTaskSequence, Event))
+	{
+		Event.Enum = static_cast<uint8>(Mode);
+		Event.Steps = MoveTemp(RecordedSteps);
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordInputValue(const UAbilityTask* Task, const FInputActionValue& Value)
+{
+	if (const uint32* TaskId = TaskIds.Find(Task))
+	{
+		FGASDBRecordedEvent Event;
+		Event.Type = EGASDBRecordedEventType::InputValue;
+		Event.TaskId = *TaskId;
+		Event.Enum = static_cast<uint8>(Value.GetValueType());
+		Event.Vector = FVector3f(Value.Get<FVector>());
+		Write(Event);
+	}
+}
+
+void FGASDBTaskRecorder::RecordTaskEnded(const UAbilityTask* Task)
+{
+	uint32 TaskId = 0;
+	if (TaskIds.RemoveAndCopyValue(Task, TaskId))
+	{
+		FGASDBRecordedEvent Event;
+		Event.Type = EGASDBRecordedEventType::TaskEnded;
+		Event.TaskId = TaskId;
+		Write(Event);
+	}
+}
+
+bool FGASDBTaskReplayer::Load(const FString& FilePath, FString& OutError)
+{
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader)
+	{
+		OutError = FString::Printf(TEXT("could not open %s"), *FilePath);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	*Reader << Magic << Version;
+	if (Magic != FGASDBTaskRecorder::FileMagic || Version != FGASDBTaskRecorder::FileVersion)
+	{
+		OutError = FString::Printf(TEXT("%s is not a version %u GASDB task recording"), *FilePath, FGASDBTaskRecorder::FileVersion);
+		return false;
+	}
+
+	Events.Reset();
+	Objects.Reset();
+	AvatarLocations.Reset();
+	LiveTasks.Reset();
+	NextEvent = 0;
+	NumTaskEvents = 0;
+
+	// A session that ended without gasdb.Record.Stop has no EndOfStream; play whatever was flushed.
+	double Time = 0.0;
+	while (Reader->Tell() < Reader->TotalSize())
+	{
+		FGASDBRecordedEvent Event;
+		*Reader << Event;
+		if (Reader->IsError())
+		{
+			OutError = FString::Printf(TEXT("%s is truncated or corrupt after %d records"), *FilePath, Events.Num());
+			return false;
+		}
+
+		Time += Event.DeltaMicros / 1.0e6;
+
+		switch (Event.Type)
+		{
+		case EGASDBRecordedEventType::DefineObject:
+		{
+			UObject* Object = StaticLoadObject(UObject::StaticClass(), nullptr, *Event.ObjectPath);
+			if (!Object)
+			{
+				GASDB_LOG(nullptr, Warning, TEXT("GASDB task replay: could not load %s"), *Event.ObjectPath);
+			}
+			Objects.SetNum(FMath::Max<int32>(Objects.Num(), Event.Index));
+			Objects[Event.Index - 1].Reset(Object);
+			break;
+		}
+
+		case EGASDBRecordedEventType::DefineAvatar:
+			AvatarLocations.SetNum(FMath::Max<int32>(AvatarLocations.Num(), Event.Index));
+			AvatarLocations[Event.Index - 1] = FVector(Event.Vector);
+			break;
+
+		case EGASDBRecordedEventType::EndOfStream:
+			return true;
+
+		default:
+			NumTaskEvents += Event.Type == EGASDBRecordedEventType::TaskCreated ? 1 : 0;
+			Events.Add({ Time, MoveTemp(Event) });
+			break;
+		}
+	}
+
+	return true;
+}
+
+void FGASDBTaskReplayer::SpawnAvatars(FGASDBTaskHarness& Harness) const
+{
+	Harness.SpawnAvatars(AvatarLocations.Num());
+	for (int32 Index = 0; Index < FMath::Min(AvatarLocations.Num(), Harness.GetNumAvatars()); ++Index)
+	{
+		if (AGASDBHarnessAvatar* Avatar = Harness.GetAvatar(Index))
+		{
+			Avatar->SetActorLocation(AvatarLocations[Index], false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+}
+
+int32 FGASDBTaskReplayer::GetNumLiveTasks() const
+{
+	int32 NumLive = 0;
+	for (const TPair<uint32, TWeakObjectPtr<UAbilityTask>>& Pair : LiveTasks)
+	{
+		if (Pair.Value.IsValid() && !Pair.Value->IsFinished())
+		{
+			++NumLive;
+		}
+	}
+	return NumLive;
+}
+
+UObject* FGASDBTaskReplayer::ResolveObject(const uint32 Index) const
+{
+	return Objects.IsValidIndex(static_cast<int32>(Index) - 1) ? Objects[Index - 1].Get() : nullptr;
+}
+
+int32 FGASDBTaskReplayer::Advance(FGASDBTaskHarness& Harness, const double SimSeconds)
+{
+	int32 NumCreated = 0;
+	for (; NextEvent < Events.Num() && Events[NextEvent].Time <= SimSeconds; ++NextEvent)
+	{
+		const FGASDBRecordedEvent& Event = Events[NextEvent].Event;
+		switch (Event.Type)
+		{
+		case EGASDBRecordedEventType::TaskCreated:
+			if (UAbilityTask* Task = CreateTask(Harness, Event))
+			{
+				LiveTasks.Add(Event.TaskId, Task);
+				Task->ReadyForActivation();
+				++NumCreated;
+			}
+			break;
+
+		case EGASDBRecordedEventType::TaskEnded:
+		{
+			TWeakObjectPtr<UAbilityTask> Task;
+			if (LiveTasks.RemoveAndCopyValue(Event.TaskId, Task) && Task.IsValid() && !Task->IsFinished())
+			{
+				Task->EndTask();
+			}
+			break;
+		}
+
+		case EGASDBRecordedEventType::InputValue:
+			if (const TWeakObjectPtr<UAbilityTask>* Task = LiveTasks.Find(Event.TaskId))
+			{
+				if (UAbilityTask_WaitEnhancedInputEvent* InputTask = Cast<UAbilityTask_WaitEnhancedInputEvent>(Task->Get()); InputTask && !InputTask->IsFinished())
+				{
+					InputTask->HandleInputValue(FInputActionValue(static_cast<EInputActionValueType>(Event.Enum), FVector(Event.Vector)), FPlatformTime::Seconds());
+				}
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return NumCreated;
+}
+
+UAbilityTask* FGASDBTaskReplayer::CreateTask(FGASDBTaskHarness& Harness, const FGASDBRecordedEvent& Event)
+{
+	const int32 AvatarIndex = static_cast<int32>(Event.AvatarIndex) - 1;
+	UGameplayAbility* OwningAbility = AvatarIndex >= 0 && AvatarIndex < Harness.GetNumAvatars() ? Harness.GetAbility(AvatarIndex) : nullptr;
+	if (!OwningAbility)
+	{
+		return nullptr;
+	}
+
+	switch (Event.TaskType)
+	{
+	case EGASDBRecordedTask::OnTickEvent:
+		return UAbilityTask_OnTickEvent::OnTickEvent(OwningAbility, NAME_None);
+
+	case EGASDBRecordedTask::MoveRandomly:
+		return UAbilityTask_MoveRandomly::MoveRandomlyTask(OwningAbility, NAME_None, Event.Floats[0], Event.Floats[1]);
+
+	case EGASDBRecordedTask::MoveInDirection:
+		return UAbilityTask_MoveInDirection::MoveInDirectionTask(OwningAbility, NAME_None, FVector(Event.Vector), Event.Floats[0], Event.Floats[1]);
+
+	case EGASDBRecordedTask::InstantMoveToLocation:
+		return UAbilityTask_InstantMoveToLocation::InstantMoveToLocation(OwningAbility, FVector(Event.Vector), FRotator(Event.Rotator),
+			(Event.Flags & 1) != 0, (Event.Flags & 2) != 0, (Event.Flags & 4) != 0);
+
+	case EGASDBRecordedTask::SpawnSafeActor:
+	{
+		// Keep the query load even if the recorded class is not available in this build.
+		UClass* ActorClass = Cast<UClass>(ResolveObject(Event.Index));
+		return UAbilityTask_SpawnSafeActor::SpawnSafeActor(OwningAbility, NAME_None, ActorClass ? ActorClass : AActor::StaticClass(),
+			FVector(Event.Vector), FRotator(Event.Rotator), (Event.Flags & 1) != 0);
+	}
+
+	case EGASDBRecordedTask::InputLock:
+		return UAbilityTask_InputLock::SetInputLockState(OwningAbility, (Event.Flags & 1) != 0, static_cast<EInputLockType>(Event.Enum),
+			Event.Floats[0], (Event.Flags & 2) != 0, (Event.Flags & 4) != 0);
+
+	case EGASDBRecordedTask::WaitEnhancedInputEvent:
+	{
+		UInputAction* InputAction = Cast<UInputAction>(ResolveObject(Event.Index));
+		const ETriggerEvent TriggerEvent = static_cast<ETriggerEvent>(Event.Enum);
+		const bool bShouldOnlyTriggerOnce = (Event.Flags & 1) != 0;
+		switch (static_cast<EGASDBRecordedInputMode>(Event.Flags >> 1))
+		{
+		case EGASDBRecordedInputMode::Buffered:
+			return UAbilityTask_WaitEnhancedInputEvent::WaitBufferedEnhancedInputEvent(OwningAbility, NAME_None, InputAction, TriggerEvent, Event.Floats[0], bShouldOnlyTriggerOnce);
+		case EGASDBRecordedInputMode::ServerForwarding:
+			return UAbilityTask_WaitEnhancedInputEvent::WaitEnhancedInputEventWithServerForwarding(OwningAbility, NAME_None, InputAction, TriggerEvent, Event.Floats[0], bShouldOnlyTriggerOnce);
+		default:
+			return UAbilityTask_WaitEnhancedInputEvent::WaitEnhancedInputEvent(OwningAbility, NAME_None, InputAction, TriggerEvent, bShouldOnlyTriggerOnce);
+		}
+	}
+
+	case EGASDBRecordedTask::RunTaskSequence:
+	{
+		TArray<FGASDBTaskStep> Steps;
+		Steps.Reserve(Event.Steps.Num());
+		for (const FGASDBRecordedEvent::FStep& RecordedStep : Event.Steps)
+		{
+			FGASDBTaskStep& Step = Steps.Add_GetRef(RecordedStep.Step);
+			Step.ActorClass = Cast<UClass>(ResolveObject(RecordedStep.ActorClassIndex));
+			Step.InputAction = Cast<UInputAction>(ResolveObject(RecordedStep.InputActionIndex));
+		}
+		return UAbilityTask_RunTaskSequence::RunTaskSequence(OwningAbility, NAME_None, Steps, static_cast<EGASDBTaskSequenceMode>(Event.Enum));
+	}
+
+	default:
+		return nullptr;
+	}
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice GASDBRecordStartCommand(
+	TEXT("gasdb.Record.Start"),
+	TEXT("Records GASDB task activations, ends and input to a binary file. Usage: gasdb.Record.Start [path] [World=Authority|Client|Any]"),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		FString FilePath = FPaths::ProjectSavedDir() / TEXT("Profiling") / FString::Printf(TEXT("GASDBTasks-%s.gasdbrec"), *FDateTime::Now().ToString());
+		EGASDBRecordWorld WorldFilter = EGASDBRecordWorld::Authority;
+		for (const FString& Arg : Args)
+		{
+			FString WorldName;
+			if (FParse::Value(*Arg, TEXT("World="), WorldName))
+			{
+				if (WorldName == TEXT("Client"))
+				{
+					WorldFilter = EGASDBRecordWorld::Client;
+				}
+				else if (WorldName == TEXT("Any"))
+				{
+					WorldFilter = EGASDBRecordWorld::Any;
+				}
+				else if (WorldName != TEXT("Authority"))
+				{
+					Ar.Logf(TEXT("Unknown world filter %s; expected Authority, Client or Any"), *WorldName);
+					return;
+				}
+			}
+			else
+			{
+				FilePath = Arg;
+			}
+		}
+
+		if (FGASDBTaskRecorder::Get().Start(FilePath, WorldFilter))
+		{
+			Ar.Logf(TEXT("Recording GASDB tasks to %s"), *FilePath);
+		}
+		else
+		{
+			Ar.Logf(TEXT("Failed to open %s"), *FilePath);
+		}
+	}));
+
+static FAutoConsoleCommand GASDBRecordStopCommand(
+	TEXT("gasdb.Record.Stop"),
+	TEXT("Stops the GASDB task recording started with gasdb.Record.Start."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FGASDBTaskRecorder::Get().Stop();
+	}));
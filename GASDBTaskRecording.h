@@ -0,0 +1,200 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilityTask_RunTaskSequence.h"
+#include "InputActionValue.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FGASDBTaskHarness;
+class UAbilityTask;
+class UInputAction;
+class UWorld;
+
+/** Task factories the recorder knows how to reproduce */
+enum class EGASDBRecordedTask : uint8
+{
+	OnTickEvent,
+	MoveRandomly,
+	MoveInDirection,
+	InstantMoveToLocation,
+	SpawnSafeActor,
+	InputLock,
+	WaitEnhancedInputEvent,
+	RunTaskSequence
+};
+
+/** Which WaitEnhancedInputEvent factory created a recorded task; stored above the trigger-once bit of FGASDBRecordedEvent::Flags */
+enum class EGASDBRecordedInputMode : uint8
+{
+	Direct,
+	Buffered,
+	ServerForwarding
+};
+
+/** Which world a recording follows when several run in one process, e.g. a PIE listen server and its clients */
+enum class EGASDBRecordWorld : uint8
+{
+	/** The first world with authority (standalone, listen or dedicated server) a task is created in */
+	Authority,
+	/** The first network client world a task is created in */
+	Client,
+	/** Every world; tasks of the same activation are recorded once per world */
+	Any
+};
+
+enum class EGASDBRecordedEventType : uint8
+{
+	/** Introduces an object path (actor class, input action) under a new index */
+	DefineObject,
+	/** Introduces an avatar under a new index with its location when first seen */
+	DefineAvatar,
+	TaskCreated,
+	TaskEnded,
+	/** An input value handled by a recorded WaitEnhancedInputEvent task */
+	InputValue,
+	EndOfStream
+};
+
+/**
+ * One record of a .gasdbrec stream. Only the fields the type needs are serialized; object references are written as
+ * indices into the DefineObject table and the time as packed microseconds since the previous record.
+ */
+struct FGASDBRecordedEvent
+{
+	struct FStep
+	{
+		FGASDBTaskStep Step;
+		uint32 ActorClassIndex = 0;
+		uint32 InputActionIndex = 0;
+	};
+
+	EGASDBRecordedEventType Type = EGASDBRecordedEventType::EndOfStream;
+	uint32 DeltaMicros = 0;
+
+	/** DefineObject / DefineAvatar / object references: 1-based, 0 means none */
+	uint32 Index = 0;
+	FString ObjectPath;
+
+	uint32 TaskId = 0;
+	uint32 AvatarIndex = 0;
+	EGASDBRecordedTask TaskType = EGASDBRecordedTask::OnTickEvent;
+
+	FVector3f Vector = FVector3f::ZeroVector;
+	FRotator3f Rotator = FRotator3f::ZeroRotator;
+	float Floats[3] = {};
+	uint8 Flags = 0;
+	uint8 Enum = 0;
+	TArray<FStep, TInlineAllocator<4>> Steps;
+
+	friend FArchive& operator<<(FArchive& Ar, FGASDBRecordedEvent& Event);
+};
+
+/**
+ * Records GASDB task creations, their parameters and timings, task ends and WaitEnhancedInputEvent input from a live
+ * session to a compact binary file (gasdb.Record.Start [path] [World=Authority|Client|Any] / gasdb.Record.Stop). Only
+ * one world is recorded by default, so a PIE session with a listen server and clients does not record every task twice.
+ * FGASDBTaskReplayer plays the file back headlessly through the same task factories. Game thread only.
+ */
+class LYRAGAME_API FGASDBTaskRecorder
+{
+public:
+	static constexpr uint32 FileMagic = 0x52424447; // "GDBR"
+	static constexpr uint16 FileVersion = 1;
+
+	static FGASDBTaskRecorder& Get();
+
+	static bool IsRecording() { return bRecording; }
+
+	bool Start(const FString& FilePath, EGASDBRecordWorld InWorldFilter = EGASDBRecordWorld::Authority);
+
+	void Stop();
+
+	void RecordOnTickEvent(const UAbilityTask* Task);
+	void RecordMoveRandomly(const UAbilityTask* Task, float DirectionChangeInterval, float TotalDuration);
+	void RecordMoveInDirection(const UAbilityTask* Task, const FVector& Direction, float Interval, float Duration);
+	void RecordInstantMove(const UAbilityTask* Task, const FVector& TargetLocation, const FRotator& TargetRotation, bool bSweep, bool bStopAtCollision, bool bSetRotation);
+	void RecordSpawnSafeActor(const UAbilityTask* Task, const UClass* ActorClass, const FVector& Location, const FRotator& Rotation, bool bMoveEncroachingActors);
+	void RecordInputLock(const UAbilityTask* Task, bool bShouldLock, uint8 LockType, float Duration, bool bLockMove, bool bLockLook);
+	void RecordWaitEnhancedInputEvent(const UAbilityTask* Task, const UInputAction* InputAction, ETriggerEvent TriggerEvent, EGASDBRecordedInputMode Mode, float Window, bool bShouldOnlyTriggerOnce);
+	void RecordTaskSequence(const UAbilityTask* Task, TConstArrayView<FGASDBTaskStep> Steps, EGASDBTaskSequenceMode Mode);
+	void RecordInputValue(const UAbilityTask* Task, const FInputActionValue& Value);
+	void RecordTaskEnded(const UAbilityTask* Task);
+
+private:
+	/** Fills in the task id and avatar of a TaskCreated record; false if the task has no avatar to attach it to or is in a world that is not recorded */
+	bool BeginTaskCreated(const UAbilityTask* Task, EGASDBRecordedTask TaskType, FGASDBRecordedEvent& OutEvent);
+
+	/** Applies WorldFilter, locking the recording to the first matching world */
+	bool ShouldRecordWorld(const UWorld* World);
+
+	uint32 GetObjectIndex(const UObject* Object);
+
+	void Write(FGASDBRecordedEvent& Event);
+
+	static bool bRecording;
+
+	TUniquePtr<FArchive> FileWriter;
+
+	double LastEventTime = 0.0;
+
+	uint32 NextTaskId = 1;
+
+	EGASDBRecordWorld WorldFilter = EGASDBRecordWorld::Authority;
+
+	TWeakObjectPtr<const UWorld> RecordedWorld;
+
+	TMap<FObjectKey, uint32> TaskIds;
+
+	TMap<FObjectKey, uint32> AvatarIndices;
+
+	TMap<FObjectKey, uint32> ObjectIndices;
+};
+
+/** Plays a .gasdbrec stream back on the avatars of a FGASDBTaskHarness. */
+class LYRAGAME_API FGASDBTaskReplayer
+{
+public:
+	bool Load(const FString& FilePath, FString& OutError);
+
+	/** Spawns one harness avatar per recorded avatar and moves it to where it was first seen */
+	void SpawnAvatars(FGASDBTaskHarness& Harness) const;
+
+	/** Dispatches every record up to SimSeconds after the start of the recording. Returns the number of tasks created. */
+	int32 Advance(FGASDBTaskHarness& Harness, double SimSeconds);
+
+	bool IsFinished() const { return NextEvent >= Events.Num(); }
+
+	double GetDuration() const { return Events.Num() > 0 ? Events.Last().Time : 0.0; }
+
+	int32 GetNumTaskEvents() const { return NumTaskEvents; }
+
+	int32 GetNumLiveTasks() const;
+
+private:
+	struct FTimedEvent
+	{
+		double Time = 0.0;
+		FGASDBRecordedEvent Event;
+	};
+
+	UAbilityTask* CreateTask(FGASDBTaskHarness& Harness, const FGASDBRecordedEvent& Event);
+
+	UObject* ResolveObject(uint32 Index) const;
+
+	TArray<FTimedEvent> Events;
+
+	TArray<TStrongObjectPtr<UObject>> Objects;
+
+	TArray<FVector> AvatarLocations;
+
+	TMap<uint32, TWeakObjectPtr<UAbilityTask>> LiveTasks;
+
+	int32 NextEvent = 0;
+
+	int32 NumTaskEvents = 0;
+};
+
+/** Cheap when not recording: a single bool test. */
+#define GASDB_RECORD(Call) \
+	do { if (FGASDBTaskRecorder::IsRecording()) { FGASDBTaskRecorder::Get().Call; } } while (0)
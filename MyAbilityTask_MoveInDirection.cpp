@@ -3,13 +3,18 @@
 // MyAbilityTask_MoveInDirection.cpp
 
 #include "AbilityTask_MoveInDirection.h"
+#include "GASDBAbilityTaskPool.h"
+#include "GASDBLatencyTracer.h"
+#include "GASDBTaskBudgetSubsystem.h"
+#include "GASDBTaskMetrics.h"
+#include "GASDBTaskRecording.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
 
 UAbilityTask_MoveInDirection* UAbilityTask_MoveInDirection::MoveInDirectionTask(UGameplayAbility* OwningAbility, FName TaskInstanceName, FVector Direction, float Interval, float Duration)
 {
-	UAbilityTask_MoveInDirection* MyTask = NewAbilityTask<UAbilityTask_MoveInDirection>(OwningAbility, TaskInstanceName);
+	UAbilityTask_MoveInDirection* MyTask = UGASDBAbilityTaskPool::NewPooledAbilityTask<UAbilityTask_MoveInDirection>(OwningAbility, TaskInstanceName);
 	MyTask->MoveDirection = Direction.GetSafeNormal();
 	MyTask->MoveInterval = Interval;
 	MyTask->MoveDuration = Duration;
@@ -20,17 +25,33 @@ UAbilityTask_MoveInDirection* UAbilityTask_MoveInDirection::MoveInDirectionTask(
 
 void UAbilityTask_MoveInDirection::Activate()
 {
+	GASDB_SCOPE(MoveInDirection_Activate);
+
 	Super::Activate();
 
+	GASDB_LATENCY_STAGE(Ability, TaskActivated);
+	GASDB_RECORD(RecordMoveInDirection(this, MoveDirection, MoveInterval, MoveDuration));
+
 	GetWorld()->GetTimerManager().SetTimer(TimerHandle, this, &UAbilityTask_MoveInDirection::MoveCharacter, MoveInterval, true);
+	FGASDBTaskMetrics::NoteTimerSet(TimerHandle);
 }
 
 void UAbilityTask_MoveInDirection::MoveCharacter()
 {
 	TimePassed += MoveInterval;
+
+	// With an interval shorter than the frame, the input of a second firing would be summed into the first and clamped away.
+	if (TimePassed < MoveDuration && UGASDBTaskBudgetSubsystem::ShouldCollapseUpdate(this, EGASDBTaskBudgetCategory::Movement, LastUpdateFrame))
+	{
+		return;
+	}
+
+	GASDB_SCOPE(MoveInDirection_TimerCallback);
+	GASDB_BUDGET_SCOPE(Movement);
+
 	if (TimePassed >= MoveDuration)
 	{
-		OnDestroy(false);
+		EndTask();
 		return;
 	}
 
@@ -38,11 +59,31 @@ void UAbilityTask_MoveInDirection::MoveCharacter()
 	if (Character)
 	{
 		Character->AddMovementInput(MoveDirection, 1.0f);
+		GASDB_LATENCY_STAGE(Ability, EffectApplied);
 	}
 }
 
 void UAbilityTask_MoveInDirection::OnDestroy(bool AbilityEnded)
 {
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+	if (UWorld* World = GetWorld())
+	{
+		FGASDBTaskMetrics::ClearTimer(World->GetTimerManager(), TimerHandle);
+	}
+	TimerHandle.Invalidate();
+
 	Super::OnDestroy(AbilityEnded);
+
+	UGASDBAbilityTaskPool::Release(this);
+}
+
+void UAbilityTask_MoveInDirection::ResetPooledState()
+{
+	MoveDirection = FVector::ZeroVector;
+	MoveInterval = 0.f;
+	MoveDuration = 0.f;
+	TimePassed = 0.f;
+	TimerHandle.Invalidate();
+	OwningAbility = nullptr;
+	LastUpdateFrame = MAX_uint64;
+	bOwnerFinished = false;
 }